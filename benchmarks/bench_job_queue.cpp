@@ -0,0 +1,101 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+// Compares util::producer_consumer_list, which allocates one node per
+// element, to the intrusive producer_consumer_list used by the schedulers.
+// Each run lets 1 to 64 producers enqueue a total of N elements that are
+// dequeued by a single consumer.
+//
+// Usage: bench_job_queue [N]
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "cppa/util/producer_consumer_list.hpp"
+#include "cppa/intrusive/producer_consumer_list.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+struct job {
+    atomic<job*> next;
+};
+
+template<class Queue>
+double run(size_t num_producers, size_t num_jobs) {
+    Queue q;
+    auto jobs_per_producer = num_jobs / num_producers;
+    vector<vector<job>> jobs(num_producers);
+    for (auto& vec : jobs) vec = vector<job>(jobs_per_producer);
+    atomic<bool> go{false};
+    vector<thread> producers;
+    for (auto& vec : jobs) {
+        producers.emplace_back([&] {
+            while (!go) this_thread::yield();
+            for (auto& j : vec) q.push_back(&j);
+        });
+    }
+    auto t0 = chrono::steady_clock::now();
+    go = true;
+    for (size_t n = 0; n < jobs_per_producer * num_producers; ) {
+        if (q.try_pop()) ++n;
+    }
+    auto t1 = chrono::steady_clock::now();
+    for (auto& t : producers) t.join();
+    return chrono::duration<double, milli>(t1 - t0).count();
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    size_t num_jobs = 1000000;
+    if (argc > 1) num_jobs = static_cast<size_t>(atol(argv[1]));
+    cout << "dequeue " << num_jobs << " jobs from N producers (ms)" << endl
+         << setw(10) << "producers"
+         << setw(12) << "util"
+         << setw(12) << "intrusive" << endl;
+    for (size_t producers = 1; producers <= 64; producers *= 2) {
+        auto t1 = run<util::producer_consumer_list<job>>(producers, num_jobs);
+        auto t2 = run<intrusive::producer_consumer_list<job>>(producers,
+                                                              num_jobs);
+        cout << fixed << setprecision(2)
+             << setw(10) << producers
+             << setw(12) << t1
+             << setw(12) << t2 << endl;
+    }
+}
@@ -0,0 +1,191 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+// Measures the throughput of the middleman with 1, 2, and 4 event loops.
+// A server process publishes a dispatcher that spawns one echo actor per
+// client, then launches P client processes that connect via loopback and
+// send N pings each to their echo actor (with up to 100 pings in flight).
+// Throughput is computed from the earliest client start to the latest
+// client end.
+//
+// Usage: bench_middleman_loops [P] [N]
+
+#include <thread>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <limits>
+#include <iostream>
+#include <algorithm>
+
+#include "cppa/cppa.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+constexpr size_t max_pings_in_flight = 100;
+
+int64_t ticks() {
+    // steady_clock is system-wide, i.e., its values are
+    // comparable between processes on the same host
+    auto t = chrono::steady_clock::now().time_since_epoch();
+    return chrono::duration_cast<chrono::microseconds>(t).count();
+}
+
+behavior echo(event_based_actor* self, actor listener) {
+    return (
+        on(atom("ping"), arg_match) >> [](int i) {
+            return make_any_tuple(atom("pong"), i);
+        },
+        on(atom("done"), arg_match) >> [=](int64_t t0, int64_t t1) {
+            self->send(listener, atom("done"), t0, t1);
+            self->quit();
+        }
+    );
+}
+
+behavior dispatcher(event_based_actor* self, actor listener) {
+    return (
+        on(atom("hello")) >> [=] {
+            return make_any_tuple(self->spawn(echo, listener));
+        },
+        on(atom("quit")) >> [=] {
+            self->quit();
+        }
+    );
+}
+
+void run_client(uint16_t port, size_t num_msgs) {
+    auto srv = remote_actor("127.0.0.1", port);
+    scoped_actor self;
+    actor peer;
+    self->sync_send(srv, atom("hello")).await(
+        on_arg_match >> [&](const actor& ptr) { peer = ptr; }
+    );
+    auto t0 = ticks();
+    size_t sent = 0;
+    auto initial = min(max_pings_in_flight, num_msgs);
+    for (; sent < initial; ++sent) {
+        self->send(peer, atom("ping"), static_cast<int>(sent));
+    }
+    size_t received = 0;
+    self->receive_for(received, num_msgs) (
+        on(atom("pong"), arg_match) >> [&](int) {
+            if (sent < num_msgs) {
+                self->send(peer, atom("ping"), static_cast<int>(sent++));
+            }
+        }
+    );
+    self->send(peer, atom("done"), t0, ticks());
+}
+
+void run_server(const char* app_path, size_t num_loops,
+                size_t num_clients, size_t num_msgs) {
+    middleman_threads(num_loops);
+    scoped_actor self;
+    auto srv = spawn(dispatcher, self);
+    uint16_t port = 4242;
+    for (;;) {
+        try {
+            publish(srv, port, "127.0.0.1");
+            break;
+        }
+        catch (bind_failure&) {
+            ++port;
+        }
+    }
+    ostringstream oss;
+    oss << app_path << " client " << port << " " << num_msgs;
+    auto cmd = oss.str();
+    vector<thread> clients;
+    for (size_t i = 0; i < num_clients; ++i) {
+        clients.emplace_back([cmd] {
+            if (system(cmd.c_str()) != 0) {
+                cerr << "FATAL: command \"" << cmd << "\" failed!" << endl;
+                abort();
+            }
+        });
+    }
+    auto first = numeric_limits<int64_t>::max();
+    auto last = numeric_limits<int64_t>::min();
+    size_t i = 0;
+    self->receive_for(i, num_clients) (
+        on(atom("done"), arg_match) >> [&](int64_t t0, int64_t t1) {
+            first = min(first, t0);
+            last = max(last, t1);
+        }
+    );
+    for (auto& t : clients) t.join();
+    self->send(srv, atom("quit"));
+    auto ms = static_cast<double>(last - first) / 1000.0;
+    auto total = 2 * num_clients * num_msgs;
+    cout << fixed << setprecision(2)
+         << num_loops << " loop(s): " << total << " messages in "
+         << ms << " ms (" << (total / ms) << " msgs/ms)" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    if (argc > 1 && strcmp(argv[1], "client") == 0 && argc == 4) {
+        run_client(static_cast<uint16_t>(atoi(argv[2])),
+                   static_cast<size_t>(atol(argv[3])));
+    }
+    else if (argc > 1 && strcmp(argv[1], "server") == 0 && argc == 5) {
+        run_server(argv[0],
+                   static_cast<size_t>(atol(argv[2])),
+                   static_cast<size_t>(atol(argv[3])),
+                   static_cast<size_t>(atol(argv[4])));
+    }
+    else {
+        size_t num_clients = 8;
+        size_t num_msgs = 10000;
+        if (argc > 1) num_clients = static_cast<size_t>(atol(argv[1]));
+        if (argc > 2) num_msgs = static_cast<size_t>(atol(argv[2]));
+        cout << num_clients << " peers, " << num_msgs << " pings each, "
+             << thread::hardware_concurrency() << " core(s)" << endl;
+        // run each configuration in its own process, since the number of
+        // loops cannot be changed once the middleman is running
+        for (size_t num_loops : {1, 2, 4}) {
+            ostringstream oss;
+            oss << argv[0] << " server " << num_loops << " "
+                << num_clients << " " << num_msgs;
+            if (system(oss.str().c_str()) != 0) return 1;
+        }
+        return 0;
+    }
+    await_all_actors_done();
+    shutdown();
+}
@@ -0,0 +1,181 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+// Measures the receive path of the middleman. A client process sends N
+// one-way messages carrying a string payload of S bytes to an actor
+// published by the server process. The server reports the number of
+// messages per millisecond and the number of heap allocations per message
+// (in all threads) between the first and the last received message.
+//
+// Usage: bench_remote_receive [N] [S]
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <iostream>
+
+#include "cppa/cppa.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+atomic<size_t> s_allocations{0};
+
+} // namespace <anonymous>
+
+void* operator new(size_t num_bytes) {
+    s_allocations.fetch_add(1, memory_order_relaxed);
+    auto result = malloc(num_bytes == 0 ? 1 : num_bytes);
+    if (result == nullptr) throw bad_alloc{};
+    return result;
+}
+
+void operator delete(void* ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+    free(ptr);
+}
+
+namespace {
+
+behavior sink(event_based_actor* self, actor listener, size_t num_msgs) {
+    auto received = make_shared<size_t>(0);
+    auto t0 = make_shared<chrono::steady_clock::time_point>();
+    auto a0 = make_shared<size_t>(0);
+    return (
+        on(atom("data"), arg_match) >> [=](int, const string&) {
+            if (++*received == 1) {
+                *t0 = chrono::steady_clock::now();
+                *a0 = s_allocations.load();
+            }
+            else if (*received == num_msgs) {
+                auto allocs = s_allocations.load() - *a0;
+                auto t1 = chrono::steady_clock::now();
+                auto us = chrono::duration_cast<chrono::microseconds>(t1 - *t0);
+                self->send(listener, atom("result"),
+                           static_cast<int64_t>(us.count()),
+                           static_cast<int64_t>(allocs));
+                self->quit();
+            }
+        }
+    );
+}
+
+void run_client(uint16_t port, size_t num_msgs, size_t payload_size) {
+    auto srv = remote_actor("127.0.0.1", port);
+    scoped_actor self;
+    string payload(payload_size, 'x');
+    for (size_t i = 0; i < num_msgs; ++i) {
+        self->send(srv, atom("data"), static_cast<int>(i), payload);
+    }
+    // wait for the server to close the connection
+    self->monitor(srv);
+    self->receive(
+        on_arg_match >> [](const down_msg&) { }
+    );
+}
+
+void run_server(const char* app_path, size_t num_msgs, size_t payload_size) {
+    scoped_actor self;
+    auto srv = spawn(sink, self, num_msgs);
+    uint16_t port = 4242;
+    for (;;) {
+        try {
+            publish(srv, port, "127.0.0.1");
+            break;
+        }
+        catch (bind_failure&) {
+            ++port;
+        }
+    }
+    ostringstream oss;
+    oss << app_path << " client " << port << " "
+        << num_msgs << " " << payload_size;
+    auto cmd = oss.str();
+    thread client{[cmd] {
+        if (system(cmd.c_str()) != 0) {
+            cerr << "FATAL: command \"" << cmd << "\" failed!" << endl;
+            abort();
+        }
+    }};
+    self->receive(
+        on(atom("result"), arg_match) >> [&](int64_t us, int64_t allocs) {
+            auto ms = static_cast<double>(us) / 1000.0;
+            cout << fixed << setprecision(2)
+                 << payload_size << " byte payload: "
+                 << num_msgs << " messages in " << ms << " ms ("
+                 << (num_msgs / ms) << " msgs/ms, "
+                 << (static_cast<double>(allocs) / num_msgs)
+                 << " allocations/msg)" << endl;
+        }
+    );
+    client.join();
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    if (argc == 5 && strcmp(argv[1], "client") == 0) {
+        run_client(static_cast<uint16_t>(atoi(argv[2])),
+                   static_cast<size_t>(atol(argv[3])),
+                   static_cast<size_t>(atol(argv[4])));
+    }
+    else if (argc == 4 && strcmp(argv[1], "server") == 0) {
+        run_server(argv[0],
+                   static_cast<size_t>(atol(argv[2])),
+                   static_cast<size_t>(atol(argv[3])));
+    }
+    else {
+        size_t num_msgs = 100000;
+        if (argc > 1) num_msgs = static_cast<size_t>(atol(argv[1]));
+        // run each configuration in its own process to start
+        // with an idle middleman and empty caches
+        for (size_t payload_size : {16, 1024}) {
+            if (argc > 2) payload_size = static_cast<size_t>(atol(argv[2]));
+            ostringstream oss;
+            oss << argv[0] << " server " << num_msgs << " " << payload_size;
+            if (system(oss.str().c_str()) != 0) return 1;
+            if (argc > 2) break;
+        }
+        return 0;
+    }
+    await_all_actors_done();
+    shutdown();
+}
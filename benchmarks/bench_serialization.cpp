@@ -0,0 +1,159 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+// Compares the statically bound binary serialization of announced types
+// with the generic path through the virtual serializer interface. The
+// generic path is forced by using a class derived from binary_serializer,
+// which produces identical output but is not recognized by the fast path.
+// Each input is serialized N times in both ways; the benchmark prints
+// objects per millisecond and aborts if the outputs differ.
+//
+// Usage: bench_serialization [N]
+
+#include <list>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+#include "cppa/cppa.hpp"
+#include "cppa/binary_serializer.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+struct struct_a {
+    int x;
+    int y;
+};
+
+bool operator==(const struct_a& lhs, const struct_a& rhs) {
+    return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
+struct struct_b {
+    struct_a a;
+    int z;
+    list<int> ints;
+    string name;
+};
+
+bool operator==(const struct_b& lhs, const struct_b& rhs) {
+    return lhs.a == rhs.a && lhs.z == rhs.z
+           && lhs.ints == rhs.ints && lhs.name == rhs.name;
+}
+
+struct sample {
+    uint64_t id;
+    double value;
+    float weight;
+    atom_value tag;
+    string label;
+};
+
+bool operator==(const sample& lhs, const sample& rhs) {
+    return lhs.id == rhs.id && lhs.value == rhs.value
+           && lhs.weight == rhs.weight && lhs.tag == rhs.tag
+           && lhs.label == rhs.label;
+}
+
+// not recognized by the fast path, see default_uniform_type_info
+class virtual_binary_serializer : public binary_serializer {
+
+ public:
+
+    using binary_serializer::binary_serializer;
+
+};
+
+template<typename Serializer, typename T>
+double run(const T& what, size_t num, util::buffer& buf) {
+    auto t0 = chrono::steady_clock::now();
+    for (size_t i = 0; i < num; ++i) {
+        buf.clear();
+        Serializer s(&buf);
+        s << what;
+    }
+    auto t1 = chrono::steady_clock::now();
+    auto us = chrono::duration_cast<chrono::microseconds>(t1 - t0).count();
+    return (num * 1000.0) / max<decltype(us)>(us, 1);
+}
+
+template<typename T>
+bool measure(const char* name, const T& what, size_t num) {
+    util::buffer fast_buf;
+    util::buffer slow_buf;
+    auto fast = run<binary_serializer>(what, num, fast_buf);
+    auto slow = run<virtual_binary_serializer>(what, num, slow_buf);
+    if (   fast_buf.size() != slow_buf.size()
+        || memcmp(fast_buf.data(), slow_buf.data(), fast_buf.size()) != 0) {
+        cerr << name << ": outputs differ" << endl;
+        return false;
+    }
+    cout << fixed << setprecision(2)
+         << setw(16) << left << name << right
+         << setw(6) << fast_buf.size() << " bytes: "
+         << setw(10) << slow << " -> " << setw(10) << fast
+         << " objects/ms (" << (fast / slow) << "x)" << endl;
+    return true;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    size_t num = argc > 1 ? static_cast<size_t>(atoi(argv[1])) : 100000;
+    announce<struct_a>(&struct_a::x, &struct_a::y);
+    announce<struct_b>(&struct_b::a, &struct_b::z,
+                       &struct_b::ints, &struct_b::name);
+    announce<sample>(&sample::id, &sample::value, &sample::weight,
+                     &sample::tag, &sample::label);
+    announce<vector<struct_b>>();
+    announce<vector<sample>>();
+    announce<vector<int32_t>>();
+    announce<vector<double>>();
+    announce<vector<uint8_t>>();
+    struct_b b{struct_a{1, -2}, 3, {4, 5, 6, 7}, "struct_b"};
+    sample smp{42, 3.14, 0.5f, atom("sample"), "sample"};
+    bool ok =    measure("struct_a", struct_a{1, 2}, num)
+              && measure("struct_b", b, num)
+              && measure("sample", smp, num)
+              && measure("vector<struct_b>", vector<struct_b>(32, b), num / 32)
+              && measure("vector<sample>", vector<sample>(32, smp), num / 32)
+              && measure("vector<int32_t>", vector<int32_t>(1024, -42), num / 32)
+              && measure("vector<double>", vector<double>(1024, 0.5), num / 32)
+              && measure("vector<uint8_t>", vector<uint8_t>(4096, 42), num / 32);
+    shutdown();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,126 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+// Measures how long an event-based actor needs to process N messages it
+// skipped while waiting for a synchronous response. The client receives
+// all N messages while awaiting the response, i.e., they end up in its
+// cache and are processed from there once the response arrives.
+//
+// Usage: bench_skipped_messages [N]
+
+#include <chrono>
+#include <memory>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "cppa/cppa.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+// replies to 'ping' as soon as it receives 'reply'
+struct server : event_based_actor {
+
+    behavior make_behavior() override {
+        return (
+            on(atom("ping")) >> [=] {
+                m_promise = make_response_promise();
+                become (
+                    on(atom("reply")) >> [=] {
+                        m_promise.deliver(make_any_tuple(atom("pong")));
+                        quit();
+                    }
+                );
+            }
+        );
+    }
+
+    response_promise m_promise;
+
+};
+
+// counts integers, but awaits a response from the server first
+struct client : event_based_actor {
+
+    client(actor srv, actor listener, size_t num_msgs)
+            : m_server(srv), m_listener(listener)
+            , m_num_msgs(num_msgs), m_count(0) { }
+
+    behavior make_behavior() override {
+        return (
+            on(atom("go")) >> [=] {
+                sync_send(m_server, atom("ping")).then(
+                    on(atom("pong")) >> [] { }
+                );
+            },
+            on_arg_match >> [=](int) {
+                if (++m_count == m_num_msgs) {
+                    send(m_listener, atom("done"));
+                    quit();
+                }
+            }
+        );
+    }
+
+    actor m_server;
+    actor m_listener;
+    size_t m_num_msgs;
+    size_t m_count;
+
+};
+
+double run(size_t num_msgs) {
+    scoped_actor self;
+    auto srv = spawn<server>();
+    auto cl = spawn<client>(srv, self, num_msgs);
+    auto t0 = chrono::steady_clock::now();
+    self->send(cl, atom("go"));
+    for (size_t i = 0; i < num_msgs; ++i) self->send(cl, static_cast<int>(i));
+    self->send(srv, atom("reply"));
+    self->receive(on(atom("done")) >> [] { });
+    auto t1 = chrono::steady_clock::now();
+    return chrono::duration<double, milli>(t1 - t0).count();
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    size_t num_msgs = 10000;
+    if (argc > 1) num_msgs = static_cast<size_t>(atol(argv[1]));
+    auto t = run(num_msgs);
+    cout << fixed << setprecision(2)
+         << "processed " << num_msgs << " skipped messages in "
+         << t << " ms" << endl;
+    await_all_actors_done();
+    shutdown();
+}
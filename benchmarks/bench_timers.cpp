@@ -0,0 +1,189 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+// Compares the timing wheel used by the timer threads to the std::multimap
+// it replaced. Each run inserts N timers with deadlines of up to one minute,
+// cancels every other timer (a superseded receive timeout), and fires the
+// remaining timers. Afterwards, N actors receive one delayed message each
+// to measure the end-to-end throughput and lateness of delayed_send.
+//
+// Usage: bench_timers [N]
+
+#include <map>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "cppa/cppa.hpp"
+
+#include "cppa/detail/timing_wheel.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+typedef chrono::high_resolution_clock hrc;
+
+typedef hrc::time_point time_point;
+
+struct timings {
+    double insert;
+    double cancel;
+    double fire;
+};
+
+double ms_since(const time_point& t0) {
+    return chrono::duration<double, milli>(hrc::now() - t0).count();
+}
+
+vector<chrono::milliseconds> random_delays(size_t num) {
+    mt19937 rng{42};
+    uniform_int_distribution<int> dist{1, 60000};
+    vector<chrono::milliseconds> result;
+    for (size_t i = 0; i < num; ++i) {
+        result.emplace_back(dist(rng));
+    }
+    return result;
+}
+
+timings run_multimap(const time_point& now,
+                     const vector<chrono::milliseconds>& delays) {
+    timings result;
+    size_t fired = 0;
+    multimap<time_point, size_t> timers;
+    vector<multimap<time_point, size_t>::iterator> handles;
+    handles.reserve(delays.size());
+    auto t0 = hrc::now();
+    for (size_t i = 0; i < delays.size(); ++i) {
+        handles.push_back(timers.emplace(now + delays[i], i));
+    }
+    result.insert = ms_since(t0);
+    t0 = hrc::now();
+    for (size_t i = 0; i < handles.size(); i += 2) timers.erase(handles[i]);
+    result.cancel = ms_since(t0);
+    t0 = hrc::now();
+    // fire in steps of one millisecond, as a timer thread would
+    auto end = now + chrono::seconds(61);
+    for (auto tp = now; tp < end; tp += chrono::milliseconds(1)) {
+        auto i = timers.begin();
+        while (i != timers.end() && i->first <= tp) {
+            fired += i->second;
+            timers.erase(i);
+            i = timers.begin();
+        }
+    }
+    result.fire = ms_since(t0);
+    if (!timers.empty() || fired == 0) cerr << "*** multimap failed" << endl;
+    return result;
+}
+
+timings run_wheel(const time_point& now,
+                  const vector<chrono::milliseconds>& delays) {
+    typedef detail::timing_wheel<size_t> wheel_type;
+    timings result;
+    size_t fired = 0;
+    wheel_type timers{chrono::milliseconds(1), now};
+    vector<wheel_type::entry*> handles;
+    handles.reserve(delays.size());
+    auto t0 = hrc::now();
+    for (size_t i = 0; i < delays.size(); ++i) {
+        handles.push_back(timers.add(now + delays[i], i));
+    }
+    result.insert = ms_since(t0);
+    t0 = hrc::now();
+    for (size_t i = 0; i < handles.size(); i += 2) timers.cancel(handles[i]);
+    result.cancel = ms_since(t0);
+    t0 = hrc::now();
+    auto end = now + chrono::seconds(61);
+    for (auto tp = now; tp < end; tp += chrono::milliseconds(1)) {
+        timers.advance(tp, [&](size_t i) { fired += i; });
+    }
+    result.fire = ms_since(t0);
+    if (!timers.empty() || fired == 0) cerr << "*** wheel failed" << endl;
+    return result;
+}
+
+void print(const char* name, const timings& t) {
+    cout << fixed << setprecision(2)
+         << setw(10) << name
+         << setw(12) << t.insert
+         << setw(12) << t.cancel
+         << setw(12) << t.fire << endl;
+}
+
+// each actor waits for one delayed message and reports how late it was
+void run_delayed_send(size_t num_actors) {
+    atomic<size_t> done{0};
+    atomic<long long> lateness_us{0};
+    auto t0 = hrc::now();
+    for (size_t i = 0; i < num_actors; ++i) {
+        spawn([&, i](event_based_actor* self) {
+            auto delay = chrono::milliseconds(10 + i % 90);
+            auto deadline = hrc::now() + delay;
+            self->delayed_send(self, delay, atom("tick"));
+            self->become (
+                on(atom("tick")) >> [=, &done, &lateness_us] {
+                    auto late = hrc::now() - deadline;
+                    lateness_us += chrono::duration_cast<chrono::microseconds>(late).count();
+                    ++done;
+                    self->quit();
+                }
+            );
+        });
+    }
+    await_all_actors_done();
+    cout << "delayed_send to " << num_actors << " actors: "
+         << fixed << setprecision(2) << ms_since(t0) << " ms, "
+         << "average lateness " << (lateness_us / max<size_t>(done, 1))
+         << " us" << endl;
+}
+
+} // namespace <anonymous>
+
+int main(int argc, char** argv) {
+    size_t num_timers = 1000000;
+    if (argc > 1) num_timers = static_cast<size_t>(atol(argv[1]));
+    auto delays = random_delays(num_timers);
+    auto now = hrc::now();
+    cout << num_timers << " timers, cancel every other timer (ms)" << endl
+         << setw(10) << "container"
+         << setw(12) << "insert"
+         << setw(12) << "cancel"
+         << setw(12) << "fire" << endl;
+    print("multimap", run_multimap(now, delays));
+    print("wheel", run_wheel(now, delays));
+    run_delayed_send(num_timers / 10);
+    shutdown();
+}
@@ -32,6 +32,7 @@
 #define CPPA_ACTOR_NAMESPACE_HPP
 
 #include <map>
+#include <mutex>
 #include <utility>
 #include <functional>
 
@@ -48,6 +49,7 @@ namespace io { class middleman; }
 /**
  * @brief Groups a (distributed) set of actors and allows actors
  *        in the same namespace to exchange messages.
+ * @note All member functions except for the setters are thread-safe.
  */
 class actor_namespace {
 
@@ -97,9 +99,9 @@ class actor_namespace {
              const actor_proxy_ptr& proxy);
 
     /**
-     * @brief Returns the map of known actors for @p node.
+     * @brief Returns a copy of the map of known actors for @p node.
      */
-    proxy_map& proxies(node_id& node);
+    proxy_map proxies(node_id& node);
 
     /**
      * @brief Deletes all proxies for @p node.
@@ -119,6 +121,9 @@ class actor_namespace {
 
     node_id_ptr m_node;
 
+    // guards m_proxies, since the middleman may run multiple event loops
+    std::mutex m_mtx;
+
     std::map<node_id, proxy_map> m_proxies;
 
 };
@@ -32,6 +32,7 @@
 #define CPPA_BINARY_DESERIALIZER_HPP
 
 #include "cppa/deserializer.hpp"
+#include "cppa/wire_format.hpp"
 
 namespace cppa {
 
@@ -47,11 +48,25 @@ class binary_deserializer : public deserializer {
 
     binary_deserializer(const void* buf, size_t buf_size,
                         actor_namespace* ns = nullptr,
-                        type_lookup_table* table = nullptr);
+                        type_lookup_table* table = nullptr,
+                        wire_format format = wire_format::v1);
 
     binary_deserializer(const void* begin, const void* m_end,
                         actor_namespace* ns = nullptr,
-                        type_lookup_table* table = nullptr);
+                        type_lookup_table* table = nullptr,
+                        wire_format format = wire_format::v1);
+
+    inline wire_format format() const {
+        return m_format;
+    }
+
+    /**
+     * @brief Returns the number of bytes not consumed yet.
+     */
+    inline size_t remaining() const {
+        return static_cast<size_t>(static_cast<const char*>(m_end)
+                                   - static_cast<const char*>(m_pos));
+    }
 
     const uniform_type_info* begin_object() override;
     void end_object() override;
@@ -65,6 +80,7 @@ class binary_deserializer : public deserializer {
 
     const void* m_pos;
     const void* m_end;
+    wire_format m_format;
 
 };
 
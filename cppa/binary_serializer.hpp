@@ -34,11 +34,12 @@
 #include <utility>
 
 #include "cppa/serializer.hpp"
+#include "cppa/wire_format.hpp"
 #include "cppa/util/buffer.hpp"
 
-namespace cppa {
+#include "cppa/detail/binary_writer.hpp"
 
-namespace detail { class binary_writer; }
+namespace cppa {
 
 /**
  * @brief Implements the serializer interface with
@@ -56,7 +57,38 @@ class binary_serializer : public serializer {
      */
     binary_serializer(util::buffer* write_buffer,
                       actor_namespace* ns = nullptr,
-                      type_lookup_table* lookup_table = nullptr);
+                      type_lookup_table* lookup_table = nullptr,
+                      wire_format format = wire_format::v1);
+
+    /**
+     * @brief Allows this serializer to add types missing in its lookup
+     *        table, i.e., to send the name of a type only once.
+     * @note Only supported by {@link wire_format::v2}.
+     */
+    inline void intern_types(bool value) {
+        m_intern_types = value;
+    }
+
+    inline wire_format format() const {
+        return m_format;
+    }
+
+    /**
+     * @brief Writes @p value without wrapping it into a
+     *        {@link primitive_variant}, i.e., without any virtual dispatch.
+     * @note Produces exactly the same output as <tt>write_value(value)</tt>.
+     */
+    template<typename T>
+    inline void write_primitive(const T& value) {
+        detail::binary_writer(m_sink, m_format)(value);
+    }
+
+    /**
+     * @brief Non-virtual equivalent of {@link begin_sequence}.
+     */
+    inline void write_length(size_t list_size) {
+        detail::binary_writer::write_length(m_sink, m_format, list_size);
+    }
 
     void begin_object(const uniform_type_info*) override;
 
@@ -75,6 +107,8 @@ class binary_serializer : public serializer {
  private:
 
     util::buffer* m_sink;
+    wire_format m_format;
+    bool m_intern_types;
 
 };
 
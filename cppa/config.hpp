@@ -62,6 +62,11 @@
 #  error Plattform and/or compiler not supportet
 #endif
 
+// size of a cache line, used as padding to avoid false sharing
+#ifndef CPPA_CACHE_LINE_SIZE
+#  define CPPA_CACHE_LINE_SIZE 64
+#endif
+
 #include <memory>
 #include <cstdio>
 #include <cstdlib>
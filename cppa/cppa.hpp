@@ -476,6 +476,87 @@ void max_msg_size(size_t size);
  */
 size_t max_msg_size();
 
+/**
+ * @brief Sets the number of event loops (threads) the middleman
+ *        uses for network IO. Peers are distributed among all loops.
+ * @param num_threads The number of loops, a value of 0 is treated as 1.
+ * @note Has no effect once the middleman is running, i.e., this function
+ *       must be called before any networking function, e.g., before
+ *       calling {@link publish()} or {@link remote_actor()}.
+ */
+void middleman_threads(size_t num_threads);
+
+/**
+ * @brief Queries the number of event loops (threads) of the middleman.
+ */
+size_t middleman_threads();
+
+/**
+ * @brief Sets the minimum size of messages this node compresses
+ *        before sending them to other nodes. Messages are only compressed
+ *        if the receiving node supports it and if compression actually
+ *        reduces their size.
+ * @param num_bytes The minimum size of a serialized message in bytes,
+ *                  a value of 0 disables compression (default).
+ * @note Affects all messages serialized after this call.
+ */
+void compression_threshold(size_t num_bytes);
+
+/**
+ * @brief Queries the minimum size of messages this node compresses.
+ */
+size_t compression_threshold();
+
+/**
+ * @brief Sets the number of TCP connections per remote node.
+ *
+ * Messages between two actors are always sent over the same connection,
+ * i.e., their order is preserved. If there is more than one connection,
+ * the last one is reserved for messages with high priority. Connections
+ * are opened by {@link remote_actor()} when called with host and port.
+ * The nodes agree on the connections they both support, all messages
+ * are sent over a single connection if the remote node does not support
+ * connection pooling or was connected via an existing stream.
+ * @param num The number of connections, clamped to [1, 32]. The default is 1.
+ * @note Affects only nodes this node has not exchanged messages with yet.
+ * @warning Messages to different actors, e.g., an exit message of a
+ *          proxy and the last message of the remote actor, may overtake
+ *          each other when using more than one connection.
+ */
+void remote_connections(size_t num);
+
+/**
+ * @brief Queries the number of TCP connections per remote node.
+ */
+size_t remote_connections();
+
+/**
+ * @brief Sets the flow control settings for connections to other nodes.
+ *
+ * Once the number of bytes queued for a node but not yet written to the
+ * network reaches @p high, messages sent to actors on that node are
+ * handled according to @p policy until the number falls to @p low again.
+ * @param low The low watermark in bytes.
+ * @param high The high watermark in bytes, a value of 0
+ *             disables flow control (default).
+ * @param policy Selects whether to drop asynchronous messages or
+ *               to bounce synchronous requests.
+ * @note Affects only nodes this node has not exchanged messages with yet,
+ *       use {@link io::default_message_queue::watermarks()} to change
+ *       the settings of an existing connection.
+ */
+void remote_watermarks(size_t low, size_t high,
+                       io::overflow_policy policy
+                           = io::overflow_policy::drop_low_priority);
+
+/**
+ * @brief Sends <tt>{'CAPACITY', whom}</tt> to @p listener as soon as
+ *        messages to @p whom are no longer subject to flow control,
+ *        i.e., immediately if the connection is not overloaded.
+ * @see remote_watermarks()
+ */
+void notify_on_capacity(const actor_addr& whom, const actor_addr& listener);
+
 // implemented in local_actor.cpp
 /**
  * @brief Anonymously sends @p whom an exit message.
@@ -505,7 +586,9 @@ namespace detail {
 void publish_impl(abstract_actor_ptr whom, std::unique_ptr<io::acceptor> aptr);
 
 abstract_actor_ptr remote_actor_impl(io::stream_ptr_pair io,
-                                     std::set<std::string> expected_interface);
+                                     std::set<std::string> expected_interface,
+                                     const char* host = nullptr,
+                                     std::uint16_t port = 0);
 
 template<class List>
 struct typed_remote_actor_helper;
@@ -513,9 +596,12 @@ struct typed_remote_actor_helper;
 template<typename... Ts>
 struct typed_remote_actor_helper<util::type_list<Ts...>> {
     typedef typed_actor<Ts...> return_type;
-    return_type operator()(io::stream_ptr_pair conn) {
+    return_type operator()(io::stream_ptr_pair conn,
+                           const char* host = nullptr,
+                           std::uint16_t port = 0) {
         auto iface = return_type::get_interface();
-        auto tmp = remote_actor_impl(std::move(conn), std::move(iface));
+        auto tmp = remote_actor_impl(std::move(conn), std::move(iface),
+                                     host, port);
         return_type res;
         // actually safe, because remote_actor_impl throws on type mismatch
         raw_access::unsafe_assign(res, tmp);
@@ -523,7 +609,7 @@ struct typed_remote_actor_helper<util::type_list<Ts...>> {
     }
     return_type operator()(const char* host, std::uint16_t port) {
         auto ptr = io::ipv4_io_stream::connect_to(host, port);
-        return (*this)(io::stream_ptr_pair(ptr, ptr));
+        return (*this)(io::stream_ptr_pair(ptr, ptr), host, port);
     }
 };
 
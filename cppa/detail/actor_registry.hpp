@@ -31,13 +31,14 @@
 #ifndef CPPA_ACTOR_REGISTRY_HPP
 #define CPPA_ACTOR_REGISTRY_HPP
 
-#include <map>
 #include <mutex>
 #include <thread>
 #include <atomic>
 #include <cstdint>
+#include <unordered_map>
 #include <condition_variable>
 
+#include "cppa/config.hpp"
 #include "cppa/attachable.hpp"
 #include "cppa/abstract_actor.hpp"
 #include "cppa/util/shared_spinlock.hpp"
@@ -91,16 +92,47 @@ class actor_registry : public singleton_mixin<actor_registry> {
 
  private:
 
-    typedef std::map<actor_id, value_type> entries;
+    typedef std::unordered_map<actor_id, value_type> entries;
+
+    // entries are distributed to shards by their ID to avoid
+    // a single lock shared by all threads
+    static constexpr size_t num_shards = 64;
+
+    struct shard {
+        mutable util::shared_spinlock mtx;
+        entries data;
+        char pad[CPPA_CACHE_LINE_SIZE];
+    };
+
+    // the running-actors-count is the sum of all counters; each thread
+    // updates only its own counter to avoid a contended cache line
+    static constexpr size_t num_counters = 64;
+
+    struct counter {
+        std::atomic<long> value;
+        char pad[CPPA_CACHE_LINE_SIZE - sizeof(std::atomic<long>)];
+    };
+
+    inline shard& shard_for(actor_id key) {
+        return m_shards[key % num_shards];
+    }
+
+    inline const shard& shard_for(actor_id key) const {
+        return m_shards[key % num_shards];
+    }
+
+    counter& local_counter();
 
-    std::atomic<size_t> m_running;
     std::atomic<actor_id> m_ids;
 
+    counter m_running[num_counters];
+
+    // number of threads in await_running_count_equal
+    std::atomic<size_t> m_awaiting;
     std::mutex m_running_mtx;
     std::condition_variable m_running_cv;
 
-    mutable util::shared_spinlock m_instances_mtx;
-    entries m_entries;
+    shard m_shards[num_shards];
 
     actor_registry();
 
@@ -0,0 +1,166 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_BINARY_WRITER_HPP
+#define CPPA_BINARY_WRITER_HPP
+
+#include <limits>
+#include <string>
+#include <iomanip>
+#include <cstdint>
+#include <sstream>
+#include <type_traits>
+
+#include "cppa/atom.hpp"
+#include "cppa/wire_format.hpp"
+
+#include "cppa/util/buffer.hpp"
+
+#include "cppa/detail/ieee_754.hpp"
+
+namespace cppa { namespace detail {
+
+/**
+ * @brief Writes primitive values to a buffer using the binary
+ *        wire format, i.e., without going through a
+ *        {@link primitive_variant}.
+ */
+class binary_writer {
+
+ public:
+
+    binary_writer(util::buffer* sink, wire_format format)
+    : m_sink(sink), m_format(format) { }
+
+    template<typename T>
+    static inline void write_int(util::buffer* sink, const T& value) {
+        sink->write(sizeof(T), &value, util::grow_if_needed);
+    }
+
+    // writes @p value as LEB128, i.e., 7 bits per byte with
+    // the most significant bit set on all but the last byte
+    static inline void write_varint(util::buffer* sink, std::uint64_t value) {
+        std::uint8_t buf[10];
+        size_t i = 0;
+        while (value > 0x7F) {
+            buf[i++] = static_cast<std::uint8_t>((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        buf[i++] = static_cast<std::uint8_t>(value);
+        sink->write(i, buf, util::grow_if_needed);
+    }
+
+    static inline void write_length(util::buffer* sink, wire_format format,
+                                    size_t length) {
+        if (format == wire_format::v1) {
+            write_int(sink, static_cast<std::uint32_t>(length));
+        }
+        else write_varint(sink, length);
+    }
+
+    static inline void write_string(util::buffer* sink, wire_format format,
+                                    const std::string& str) {
+        write_length(sink, format, str.size());
+        sink->write(str.size(), str.c_str(), util::grow_if_needed);
+    }
+
+    template<typename T>
+    void operator()(const T& value,
+                    typename std::enable_if<std::is_integral<T>::value>::type* = 0) {
+        if (m_format == wire_format::v1 || sizeof(T) == 1) {
+            write_int(m_sink, value);
+        }
+        else write_varint(m_sink, zig_zag(value));
+    }
+
+    template<typename T>
+    void operator()(const T& value,
+                    typename std::enable_if<std::is_floating_point<T>::value>::type* = 0) {
+        auto tmp = detail::pack754(value);
+        write_int(m_sink, tmp);
+    }
+
+    // the IEEE-754 conversion does not work for long double
+    // => fall back to string serialization (event though it sucks)
+    void operator()(const long double& v) {
+        std::ostringstream oss;
+        oss << std::setprecision(std::numeric_limits<long double>::digits) << v;
+        write_string(m_sink, m_format, oss.str());
+    }
+
+    void operator()(const atom_value& val) {
+        (*this)(static_cast<uint64_t>(val));
+    }
+
+    void operator()(const std::string& str) {
+        write_string(m_sink, m_format, str);
+    }
+
+    void operator()(const std::u16string& str) {
+        write_length(m_sink, m_format, str.size());
+        for (char16_t c : str) {
+            // force writer to use exactly 16 bit
+            write_int(m_sink, static_cast<std::uint16_t>(c));
+        }
+    }
+
+    void operator()(const std::u32string& str) {
+        write_length(m_sink, m_format, str.size());
+        for (char32_t c : str) {
+            // force writer to use exactly 32 bit
+            write_int(m_sink, static_cast<std::uint32_t>(c));
+        }
+    }
+
+ private:
+
+    // maps signed integers to unsigned integers such that values
+    // with a small magnitude have a small varint representation
+    template<typename T>
+    static inline typename std::enable_if<std::is_signed<T>::value, std::uint64_t>::type
+    zig_zag(T value) {
+        auto x = static_cast<std::int64_t>(value);
+        return (static_cast<std::uint64_t>(x) << 1) ^ static_cast<std::uint64_t>(x >> 63);
+    }
+
+    template<typename T>
+    static inline typename std::enable_if<!std::is_signed<T>::value, std::uint64_t>::type
+    zig_zag(T value) {
+        return static_cast<std::uint64_t>(value);
+    }
+
+    util::buffer* m_sink;
+    wire_format m_format;
+
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_BINARY_WRITER_HPP
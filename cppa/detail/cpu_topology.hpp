@@ -0,0 +1,95 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_CPU_TOPOLOGY_HPP
+#define CPPA_CPU_TOPOLOGY_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace cppa { namespace detail {
+
+/**
+ * @brief Describes the NUMA nodes of the host and the CPUs they consist of.
+ */
+class cpu_topology {
+
+ public:
+
+    /**
+     * @brief Reads the topology from <tt>/sys/devices/system/node</tt> on
+     *        Linux. Falls back to a single node containing CPUs
+     *        <tt>0 ... hardware_concurrency() - 1</tt> on other platforms
+     *        or if the topology is not available.
+     */
+    static cpu_topology detect();
+
+    /**
+     * @brief Parses a CPU list such as <tt>0-3,8,10-11</tt>.
+     */
+    static std::vector<int> parse_cpu_list(const std::string& str);
+
+    /**
+     * @brief Pins the calling thread to @p cpu.
+     * @returns @p false if the platform does not support pinning
+     *          or if the CPU is not available.
+     */
+    static bool pin_current_thread(int cpu);
+
+    inline size_t num_nodes() const {
+        return m_nodes.size();
+    }
+
+    inline const std::vector<int>& cpus(size_t node) const {
+        return m_nodes[node];
+    }
+
+    /**
+     * @brief Returns the node of @p cpu or 0 if @p cpu is unknown.
+     */
+    size_t node_of(int cpu) const;
+
+    /**
+     * @brief Returns the node of the CPU the calling thread runs on.
+     */
+    size_t current_node() const;
+
+ private:
+
+    std::vector<std::vector<int>> m_nodes;
+    std::vector<size_t> m_cpu_to_node;
+
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_CPU_TOPOLOGY_HPP
@@ -31,13 +31,20 @@
 #ifndef CPPA_DEFAULT_UNIFORM_TYPE_INFO_IMPL_HPP
 #define CPPA_DEFAULT_UNIFORM_TYPE_INFO_IMPL_HPP
 
+#include <tuple>
+#include <limits>
 #include <memory>
+#include <vector>
+#include <typeinfo>
+#include <stdexcept>
 
 #include "cppa/unit.hpp"
 #include "cppa/anything.hpp"
 #include "cppa/serializer.hpp"
 #include "cppa/typed_actor.hpp"
 #include "cppa/deserializer.hpp"
+#include "cppa/binary_serializer.hpp"
+#include "cppa/binary_deserializer.hpp"
 
 #include "cppa/util/type_traits.hpp"
 #include "cppa/util/abstract_uniform_type_info.hpp"
@@ -45,6 +52,7 @@
 #include "cppa/detail/raw_access.hpp"
 #include "cppa/detail/types_array.hpp"
 #include "cppa/detail/type_to_ptype.hpp"
+#include "cppa/detail/ptype_to_type.hpp"
 
 namespace cppa { namespace detail {
 
@@ -118,6 +126,100 @@ struct deconst_pair<std::pair<K, V> > {
     typedef std::pair<first_type, second_type> type;
 };
 
+// true for arithmetic types the binary wire format writes as their
+// in-memory representation, i.e., for which writing a contiguous range
+// of values as one raw block is equivalent to writing each value
+// (the binary format uses host byte order and IEEE 754 floating points)
+template<typename T>
+struct is_blittable {
+    static constexpr bool value =    std::is_arithmetic<T>::value
+                                  && !std::is_same<T, bool>::value
+                                  && !std::is_same<T, long double>::value
+                                  && (   std::is_integral<T>::value
+                                      || std::numeric_limits<T>::is_iec559);
+};
+
+// wire format v2 uses varints for integers wider than one byte
+template<typename T>
+constexpr bool has_full_width(wire_format format) {
+    return format == wire_format::v1 || sizeof(T) == 1
+           || std::is_floating_point<T>::value;
+}
+
+// same as default_serialize_policy, but statically bound
+// to binary_serializer and thus without any virtual dispatch
+// except for nested types that are not primitives, lists, maps or pairs
+class binary_serialize_policy {
+
+ public:
+
+    template<typename T>
+    void operator()(const T& val, binary_serializer* s) const {
+        std::integral_constant<int, impl_id<T>()> token;
+        simpl(val, s, token);
+    }
+
+ private:
+
+    template<typename T>
+    void simpl(const T& val, binary_serializer* s, primitive_impl) const {
+        // convert to the type used by primitive_variant, e.g.,
+        // to std::string for types that are convertible to strings
+        typedef typename ptype_to_type<type_to_ptype<T>::ptype>::type ptype;
+        s->write_primitive(static_cast<const ptype&>(val));
+    }
+
+    template<typename T>
+    void simpl(const T& val, binary_serializer* s, list_impl) const {
+        s->write_length(val.size());
+        for (auto i = val.begin(); i != val.end(); ++i) {
+            (*this)(*i, s);
+        }
+    }
+
+    template<typename T>
+    void simpl(const std::vector<T>& val, binary_serializer* s,
+               list_impl token) const {
+        std::integral_constant<bool, is_blittable<T>::value> blittable;
+        simpl(val, s, token, blittable);
+    }
+
+    // writes all elements as one block if possible
+    template<typename T>
+    void simpl(const std::vector<T>& val, binary_serializer* s,
+               list_impl token, std::true_type) const {
+        if (has_full_width<T>(s->format())) {
+            s->write_length(val.size());
+            if (!val.empty()) s->write_raw(val.size() * sizeof(T), val.data());
+        }
+        else simpl<std::vector<T>>(val, s, token);
+    }
+
+    template<typename T>
+    void simpl(const std::vector<T>& val, binary_serializer* s,
+               list_impl token, std::false_type) const {
+        simpl<std::vector<T>>(val, s, token);
+    }
+
+    template<typename T>
+    void simpl(const T& val, binary_serializer* s, map_impl) const {
+        list_impl token;
+        simpl(val, s, token);
+    }
+
+    template<typename T>
+    void simpl(const T& val, binary_serializer* s, pair_impl) const {
+        (*this)(val.first, s);
+        (*this)(val.second, s);
+    }
+
+    template<typename T>
+    void simpl(const T& val, binary_serializer* s, recursive_impl) const {
+        static_types_array<T>::arr[0]->serialize(&val, s);
+    }
+
+};
+
 class default_serialize_policy {
 
  public:
@@ -151,6 +253,16 @@ class default_serialize_policy {
         s->end_sequence();
     }
 
+    template<typename T>
+    void simpl(const std::vector<T>& val, serializer* s,
+               list_impl token) const {
+        if (is_blittable<T>::value
+                && typeid(*s) == typeid(binary_serializer)) {
+            binary_serialize_policy{}(val, static_cast<binary_serializer*>(s));
+        }
+        else simpl<std::vector<T>>(val, s, token);
+    }
+
     template<typename T>
     void simpl(const T& val, serializer* s, map_impl) const {
         // lists and maps share code for serialization
@@ -187,6 +299,41 @@ class default_serialize_policy {
         d->end_sequence();
     }
 
+    template<typename T>
+    void dimpl(std::vector<T>& storage, deserializer* d,
+               list_impl token) const {
+        std::integral_constant<bool, is_blittable<T>::value> blittable;
+        dimpl(storage, d, token, blittable);
+    }
+
+    // reads all elements as one block if possible
+    template<typename T>
+    void dimpl(std::vector<T>& storage, deserializer* d,
+               list_impl token, std::true_type) const {
+        if (typeid(*d) == typeid(binary_deserializer)) {
+            auto bd = static_cast<binary_deserializer*>(d);
+            if (has_full_width<T>(bd->format())) {
+                auto size = bd->begin_sequence();
+                // check size before allocating any memory
+                if (size > bd->remaining() / sizeof(T)) {
+                    throw std::out_of_range("binary_deserializer: "
+                                            "sequence exceeds buffer");
+                }
+                storage.resize(size);
+                if (size > 0) bd->read_raw(size * sizeof(T), storage.data());
+                bd->end_sequence();
+                return;
+            }
+        }
+        dimpl<std::vector<T>>(storage, d, token);
+    }
+
+    template<typename T>
+    void dimpl(std::vector<T>& storage, deserializer* d,
+               list_impl token, std::false_type) const {
+        dimpl<std::vector<T>>(storage, d, token);
+    }
+
     template<typename T>
     void dimpl(T& storage, deserializer* d, map_impl) const {
         storage.clear();
@@ -402,6 +549,80 @@ unique_uti new_member_tinfo(GRes (C::*getter)() const,
                                 std::move(meminf)));
 }
 
+/**
+ * @brief Serializes all members of an object to a
+ *        {@link binary_serializer} in one call.
+ */
+class binary_members_writer {
+
+ public:
+
+    virtual ~binary_members_writer() { }
+
+    virtual void serialize(const void* obj, binary_serializer* s) const = 0;
+
+};
+
+template<typename T>
+struct memptr_access;
+
+template<typename T, class C>
+struct memptr_access<T C::*> {
+    typedef memptr_access_policy<T, C> type;
+};
+
+// true if all Ts are member pointers, i.e., if
+// the type was announced using member pointers only
+template<typename... Ts>
+struct all_memptrs : std::true_type { };
+
+template<typename T, typename... Ts>
+struct all_memptrs<T, Ts...> {
+    static constexpr bool value =
+           std::is_member_object_pointer<typename util::rm_const_and_ref<T>::type>::value
+        && all_memptrs<Ts...>::value;
+};
+
+template<typename... AccessPolicies>
+class binary_members_writer_impl : public binary_members_writer {
+
+ public:
+
+    binary_members_writer_impl(AccessPolicies... args)
+    : m_members(std::move(args)...) { }
+
+    void serialize(const void* obj, binary_serializer* s) const override {
+        write<0>(obj, s);
+    }
+
+ private:
+
+    template<size_t Pos>
+    inline typename std::enable_if<(Pos < sizeof...(AccessPolicies))>::type
+    write(const void* obj, binary_serializer* s) const {
+        write_member(std::get<Pos>(m_members)(obj), s);
+        write<Pos + 1>(obj, s);
+    }
+
+    template<size_t Pos>
+    inline typename std::enable_if<(Pos == sizeof...(AccessPolicies))>::type
+    write(const void*, binary_serializer*) const { }
+
+    // empty types are skipped, see member_tinfo
+    template<typename M>
+    inline typename std::enable_if<!std::is_empty<M>::value>::type
+    write_member(const M& member, binary_serializer* s) const {
+        binary_serialize_policy{}(member, s);
+    }
+
+    template<typename M>
+    inline typename std::enable_if<std::is_empty<M>::value>::type
+    write_member(const M&, binary_serializer*) const { }
+
+    std::tuple<AccessPolicies...> m_members;
+
+};
+
 template<typename T>
 class default_uniform_type_info : public util::abstract_uniform_type_info<T> {
 
@@ -409,15 +630,26 @@ class default_uniform_type_info : public util::abstract_uniform_type_info<T> {
 
     template<typename... Ts>
     default_uniform_type_info(Ts&&... args) {
+        std::integral_constant<bool, all_memptrs<Ts...>::value> token;
+        init_binary_writer(token, args...);
         push_back(std::forward<Ts>(args)...);
     }
 
     default_uniform_type_info() {
         typedef member_tinfo<T, fake_access_policy<T> > result_type;
         m_members.push_back(unique_uti(new result_type));
+        if (!std::is_empty<T>::value) {
+            typedef binary_members_writer_impl<fake_access_policy<T>> impl;
+            m_binary_writer.reset(new impl(fake_access_policy<T>{}));
+        }
     }
 
     void serialize(const void* obj, serializer* s) const override {
+        // bypass the virtual serializer interface if possible
+        if (m_binary_writer && typeid(*s) == typeid(binary_serializer)) {
+            m_binary_writer->serialize(obj, static_cast<binary_serializer*>(s));
+            return;
+        }
         // serialize each member
         for (auto& m : m_members) m->serialize(obj, s);
     }
@@ -450,6 +682,19 @@ class default_uniform_type_info : public util::abstract_uniform_type_info<T> {
         return false;
     }
 
+    template<typename... Ts>
+    void init_binary_writer(std::true_type, const Ts&... memptrs) {
+        typedef binary_members_writer_impl<
+                    typename memptr_access<Ts>::type...
+                > impl;
+        m_binary_writer.reset(new impl(memptrs...));
+    }
+
+    // getter/setter pairs and custom member type infos
+    // always use the virtual serializer interface
+    template<typename... Ts>
+    void init_binary_writer(std::false_type, const Ts&...) { }
+
     // terminates recursion
     inline void push_back() { }
 
@@ -504,6 +749,8 @@ class default_uniform_type_info : public util::abstract_uniform_type_info<T> {
 
     std::vector<unique_uti> m_members;
 
+    std::unique_ptr<binary_members_writer> m_binary_writer;
+
 };
 
 template<typename... Rs>
@@ -0,0 +1,162 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_IDLE_STRATEGY_HPP
+#define CPPA_IDLE_STRATEGY_HPP
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <cstddef>
+#include <condition_variable>
+
+namespace cppa { namespace detail {
+
+class resumable;
+
+/**
+ * @brief Implements the idle behavior of scheduler workers.
+ *
+ * A worker without job polls its job queue for a configurable number of
+ * iterations, first busy-looping, then yielding between attempts. Afterwards,
+ * it parks on a condition variable until {@link notify} wakes it up.
+ */
+class idle_strategy {
+
+ public:
+
+    /**
+     * @brief Configures how long workers poll before they are parked.
+     */
+    struct settings {
+
+        /**
+         * @brief Number of polling attempts without yielding.
+         */
+        size_t spin_iterations;
+
+        /**
+         * @brief Number of polling attempts with a call to
+         *        <tt>std::this_thread::yield()</tt> in between.
+         */
+        size_t yield_iterations;
+
+        settings(size_t spins = 100, size_t yields = 100)
+        : spin_iterations(spins), yield_iterations(yields) { }
+
+    };
+
+    /**
+     * @brief Counters collected by an idle strategy.
+     */
+    struct statistics {
+
+        /**
+         * @brief Number of unsuccessful polling attempts.
+         */
+        size_t spins;
+
+        /**
+         * @brief Number of times a worker was parked.
+         */
+        size_t parks;
+
+        /**
+         * @brief Number of times {@link notify} woke a parked worker.
+         */
+        size_t wakeups;
+
+    };
+
+    idle_strategy(const settings& config = settings{});
+
+    /**
+     * @brief Calls @p try_dequeue until it returns a job, parking
+     *        the calling thread if no job arrives while polling.
+     */
+    template<typename F>
+    resumable* await(F try_dequeue) {
+        for (;;) {
+            for (size_t i = 0; i < m_config.spin_iterations; ++i) {
+                auto job = try_dequeue();
+                if (job) return job;
+                m_spins.fetch_add(1, std::memory_order_relaxed);
+            }
+            for (size_t i = 0; i < m_config.yield_iterations; ++i) {
+                auto job = try_dequeue();
+                if (job) return job;
+                m_spins.fetch_add(1, std::memory_order_relaxed);
+                std::this_thread::yield();
+            }
+            std::unique_lock<std::mutex> guard(m_mtx);
+            m_parked.fetch_add(1);
+            // pairs with the fence in notify: either we see the new job or
+            // the producer sees that we are about to park
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            auto job = try_dequeue();
+            if (job) {
+                m_parked.fetch_sub(1);
+                return job;
+            }
+            m_parks.fetch_add(1, std::memory_order_relaxed);
+            m_cv.wait(guard);
+            m_parked.fetch_sub(1);
+        }
+    }
+
+    /**
+     * @brief Wakes up one parked worker, if any. Must be called
+     *        after a new job has been made visible to workers.
+     */
+    inline void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_parked.load() > 0) wakeup();
+    }
+
+    statistics stats() const;
+
+ private:
+
+    void wakeup();
+
+    settings m_config;
+    std::atomic<size_t> m_parked;
+    std::atomic<size_t> m_spins;
+    std::atomic<size_t> m_parks;
+    std::atomic<size_t> m_wakeups;
+    std::mutex m_mtx;
+    std::condition_variable m_cv;
+
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_IDLE_STRATEGY_HPP
@@ -32,6 +32,7 @@
 #define CPPA_MEMORY_HPP
 
 #include <new>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -47,7 +48,7 @@ namespace cppa { namespace detail {
 
 namespace {
 
-constexpr size_t s_alloc_size   = 1024*1024;    // allocate ~1mb chunks
+constexpr size_t s_alloc_size   = 64*1024;      // allocate ~64kb slabs
 constexpr size_t s_cache_size   = 10*1024*1024; // cache about 10mb per thread
 constexpr size_t s_min_elements = 5;            // don't create < 5 elements
 
@@ -65,31 +66,38 @@ class instance_wrapper {
 
     virtual ~instance_wrapper();
 
-    // calls the destructor
-    virtual void destroy() = 0;
-
-    // releases memory
-    virtual void deallocate() = 0;
+    // calls the destructor and either re-uses the memory later or
+    // releases it, depending on the cache owning this instance
+    virtual void release() = 0;
 
 };
 
-class memory_cache {
+class memory_cache : public ref_counted {
 
  public:
 
-    virtual ~memory_cache();
+    /**
+     * @brief Allocation statistics of a thread-local cache for one type.
+     */
+    struct statistics {
+        size_t allocated_slabs;  // slabs allocated by the owning thread
+        size_t released_slabs;   // slabs returned to the OS
+        size_t cached_instances; // free instances in the local cache
+        size_t remote_releases;  // instances released by other threads
+    };
 
-    // calls dtor and either releases memory or re-uses it later
-    virtual void release_instance(void*) = 0;
+    virtual ~memory_cache();
 
-    virtual std::pair<instance_wrapper*, void*> new_instance() = 0;
+    // releases all cached instances and lets other threads release
+    // instances directly from now on; called by the owning thread on exit
+    virtual void close() = 0;
 
-    // casts @p ptr to the derived type and returns it
-    virtual void* downcast(memory_managed* ptr) = 0;
+    virtual statistics stats() const = 0;
 
 };
 
-class instance_wrapper;
+// keeps a reference to @p ptr and closes it when the calling thread exits
+void add_thread_local_cache(memory_cache* ptr);
 
 template<typename T>
 class basic_memory_cache;
@@ -111,34 +119,56 @@ class memory {
         return new T (std::forward<Ts>(args)...);
     }
 
-    static inline memory_cache* get_cache_map_entry(const std::type_info*) {
-        return nullptr;
+    template<typename T>
+    static inline memory_cache::statistics stats() {
+        return {0, 0, 0, 0};
     }
 
 };
 
 #else // CPPA_DISABLE_MEM_MANAGEMENT
 
+/**
+ * @brief A thread-local slab allocator for instances of type @p T.
+ *
+ * Instances released by the owning thread are cached in a local free list.
+ * Instances released by any other thread, e.g., a mailbox element freed by
+ * its receiver, are pushed to a lock-free list of the owning cache that
+ * gets reclaimed by the owner before allocating a new slab. Once the local
+ * free list exceeds the high watermark, the least recently cached
+ * instances are released until the low watermark is reached, which
+ * returns fully unused slabs to the OS.
+ */
 template<typename T>
 class basic_memory_cache : public memory_cache {
 
+    class storage;
+
     struct wrapper : instance_wrapper {
-        ref_counted* parent;
+        storage* parent;
+        wrapper* next; // intrusive pointer for the remote release list
         union { T instance; };
-        wrapper() : parent(nullptr) { }
+        wrapper() : parent(nullptr), next(nullptr) { }
         ~wrapper() { }
         void destroy() { instance.~T(); }
         void deallocate() { parent->deref(); }
+        void release() override {
+            destroy();
+            parent->owner()->release_instance(this);
+        }
     };
 
     class storage : public ref_counted {
 
-        static constexpr size_t ne = s_alloc_size / sizeof(T);
+        static constexpr size_t ne = s_alloc_size / sizeof(wrapper);
         static constexpr size_t dsize = ne > s_min_elements ? ne : s_min_elements;
 
      public:
 
-        storage() {
+        storage(basic_memory_cache* owner) : m_owner(owner) {
+            // each slab keeps its owner alive
+            m_owner->ref();
+            ++m_owner->m_allocated_slabs;
             for (auto& elem : data) {
                 // each instance has a reference to its parent
                 elem.parent = this;
@@ -146,6 +176,13 @@ class basic_memory_cache : public memory_cache {
             }
         }
 
+        ~storage() {
+            ++m_owner->m_released_slabs;
+            m_owner->deref();
+        }
+
+        inline basic_memory_cache* owner() const { return m_owner; }
+
         typedef wrapper* iterator;
 
         iterator begin() { return data; }
@@ -154,58 +191,128 @@ class basic_memory_cache : public memory_cache {
 
      private:
 
+        basic_memory_cache* m_owner;
         wrapper data[dsize];
 
     };
 
  public:
 
-    std::vector<wrapper*> cached_elements;
+    static constexpr size_t high_watermark = s_cache_size / sizeof(wrapper);
+
+    static constexpr size_t low_watermark = high_watermark / 2;
 
-    basic_memory_cache() {
-        cached_elements.reserve(s_cache_size / sizeof(T));
+    basic_memory_cache() : m_remote(nullptr), m_allocated_slabs(0)
+                         , m_released_slabs(0), m_remote_releases(0) { }
+
+    // returns the cache of the calling thread or nullptr
+    static inline basic_memory_cache*& local_ptr() {
+        static __thread basic_memory_cache* t_cache = nullptr;
+        return t_cache;
     }
 
-    ~basic_memory_cache() {
-        for (auto e : cached_elements) e->deallocate();
+    // returns the cache of the calling thread, creating it on first use
+    static basic_memory_cache* local() {
+        auto& result = local_ptr();
+        if (!result) {
+            result = new basic_memory_cache;
+            add_thread_local_cache(result);
+        }
+        return result;
     }
 
-    void* downcast(memory_managed* ptr) {
-        return static_cast<T*>(ptr);
+    std::pair<instance_wrapper*, void*> new_instance() {
+        if (m_cached.empty()) {
+            reclaim_remote_releases();
+            if (m_cached.empty()) {
+                auto elements = new storage(this);
+                for (auto i = elements->begin(); i != elements->end(); ++i) {
+                    m_cached.push_back(i);
+                }
+            }
+        }
+        wrapper* wptr = m_cached.back();
+        m_cached.pop_back();
+        return std::make_pair(wptr, &(wptr->instance));
     }
 
+    // puts an instance whose destructor has already been called back
+    // into this cache; safe to call from any thread
+    void release_instance(wrapper* wptr) {
+        if (local_ptr() == this) {
+            m_cached.push_back(wptr);
+            if (m_cached.size() > high_watermark) shrink();
+            return;
+        }
+        m_remote_releases.fetch_add(1, std::memory_order_relaxed);
+        auto e = m_remote.load();
+        for (;;) {
+            if (e == closed_tag()) {
+                // owning thread is gone
+                wptr->deallocate();
+                return;
+            }
+            wptr->next = e;
+            if (m_remote.compare_exchange_weak(e, wptr)) return;
+        }
+    }
 
-    virtual void release_instance(void* vptr) {
-        CPPA_REQUIRE(vptr != nullptr);
-        auto ptr = reinterpret_cast<T*>(vptr);
-        CPPA_REQUIRE(ptr->outer_memory != nullptr);
-        auto wptr = static_cast<wrapper*>(ptr->outer_memory);
-        wptr->destroy();
-        if (cached_elements.capacity() > 0) cached_elements.push_back(wptr);
-        else wptr->deallocate();
+    void close() override {
+        if (local_ptr() == this) local_ptr() = nullptr;
+        take_remote_releases(m_remote.exchange(closed_tag()));
+        for (auto wptr : m_cached) wptr->deallocate();
+        m_cached.clear();
     }
 
-    virtual std::pair<instance_wrapper*, void*> new_instance() {
-        if (cached_elements.empty()) {
-            auto elements = new storage;
-            for (auto i = elements->begin(); i != elements->end(); ++i) {
-                cached_elements.push_back(i);
-            }
+    statistics stats() const override {
+        return {m_allocated_slabs.load(), m_released_slabs.load(),
+                m_cached.size(), m_remote_releases.load()};
+    }
+
+ private:
+
+    wrapper* closed_tag() const {
+        // we are *never* going to dereference the returned pointer
+        return reinterpret_cast<wrapper*>(const_cast<basic_memory_cache*>(this));
+    }
+
+    void take_remote_releases(wrapper* e) {
+        while (e != nullptr) {
+            auto next = e->next;
+            m_cached.push_back(e);
+            e = next;
         }
-        wrapper* wptr = cached_elements.back();
-        cached_elements.pop_back();
-        return std::make_pair(wptr, &(wptr->instance));
     }
 
+    void reclaim_remote_releases() {
+        take_remote_releases(m_remote.exchange(nullptr));
+        if (m_cached.size() > high_watermark) shrink();
+    }
+
+    // releases the least recently cached instances
+    void shrink() {
+        auto first = m_cached.begin();
+        auto last = first + (m_cached.size() - low_watermark);
+        for (auto i = first; i != last; ++i) (*i)->deallocate();
+        m_cached.erase(first, last);
+    }
+
+    // accessed only by the owning thread
+    std::vector<wrapper*> m_cached;
+
+    // instances released by other threads
+    std::atomic<wrapper*> m_remote;
+
+    std::atomic<size_t> m_allocated_slabs;
+    std::atomic<size_t> m_released_slabs;
+    std::atomic<size_t> m_remote_releases;
+
 };
 
 class memory {
 
     memory() = delete;
 
-    template<typename>
-    friend class basic_memory_cache;
-
  public:
 
     /*
@@ -214,27 +321,22 @@ class memory {
      */
     template<typename T, typename... Ts>
     static T* create(Ts&&... args) {
-        auto mc = get_or_set_cache_map_entry<T>();
+        auto mc = basic_memory_cache<T>::local();
         auto p = mc->new_instance();
         auto result = new (p.second) T (std::forward<Ts>(args)...);
         result->outer_memory = p.first;
         return result;
     }
 
-    static memory_cache* get_cache_map_entry(const std::type_info* tinf);
-
- private:
-
-    static void add_cache_map_entry(const std::type_info* tinf, memory_cache* instance);
-
+    /*
+     * @brief Returns the allocation statistics for @p T
+     *        of the calling thread.
+     */
     template<typename T>
-    static inline memory_cache* get_or_set_cache_map_entry() {
-        auto mc = get_cache_map_entry(&typeid(T));
-        if (!mc) {
-            mc = new basic_memory_cache<T>;
-            add_cache_map_entry(&typeid(T), mc);
-        }
-        return mc;
+    static memory_cache::statistics stats() {
+        auto mc = basic_memory_cache<T>::local_ptr();
+        if (mc) return mc->stats();
+        return {0, 0, 0, 0};
     }
 
 };
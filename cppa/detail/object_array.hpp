@@ -54,6 +54,8 @@ class object_array : public abstract_tuple {
 
     void push_back(const object& what);
 
+    void reserve(size_t num_elements);
+
     void* mutable_at(size_t pos) override;
 
     size_t size() const override;
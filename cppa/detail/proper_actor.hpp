@@ -90,17 +90,13 @@ class proper_actor_base : public Policies::resume_policy::template mixin<Base, D
         return priority_policy().cache_end();
     }
 
-    inline unique_mailbox_element_pointer cache_take_first() {
-        return priority_policy().cache_take_first();
+    inline unique_mailbox_element_pointer cache_take(cache_iterator iter) {
+        return priority_policy().cache_take(iter);
     }
 
-    template<typename Iterator>
-    inline void cache_prepend(Iterator first, Iterator last) {
-        priority_policy().cache_prepend(first, last);
-    }
-
-    inline void cache_erase(cache_iterator iter) {
-        priority_policy().cache_erase(iter);
+    inline void cache_insert(cache_iterator pos,
+                             unique_mailbox_element_pointer ptr) {
+        priority_policy().cache_insert(pos, std::move(ptr));
     }
 
     // member functions from resume policy
@@ -117,6 +113,27 @@ class proper_actor_base : public Policies::resume_policy::template mixin<Base, D
                                               awaited_response);
     }
 
+    // tries to invoke cached messages in a single pass; skipped messages
+    // keep their position in the cache while handled and dropped
+    // messages are unlinked in O(1)
+    template<class PartialFunctionOrBehavior>
+    bool invoke_message_from_cache(PartialFunctionOrBehavior& fun,
+                                   message_id awaited_response) {
+        CPPA_LOG_DEBUG(priority_policy().cache_size() << " elements in cache");
+        auto e = cache_end();
+        auto i = cache_begin();
+        while (i != e) {
+            // i refers to the successor of ptr after taking it
+            auto ptr = cache_take(i);
+            if (invoke_message(ptr, fun, awaited_response)) return true;
+            if (ptr) {
+                cache_insert(i, std::move(ptr));
+                ++i;
+            }
+        }
+        return false;
+    }
+
  protected:
 
     inline typename Policies::scheduling_policy& scheduling_policy() {
@@ -192,19 +209,7 @@ class proper_actor : public proper_actor_base<Base,
         CPPA_LOG_TRACE("");
         auto bhvr = this->bhvr_stack().back();
         auto mid = this->bhvr_stack().back_id();
-        auto e = this->cache_end();
-        CPPA_LOG_DEBUG(std::distance(this->cache_begin(), e)
-                       << " elements in cache");
-        for (auto i = this->cache_begin(); i != e; ++i) {
-            auto im = this->invoke_policy().invoke_message(this, *i, bhvr, mid);
-            if (im || !*i) {
-                this->cache_erase(i);
-                if (im) return true;
-                // start anew, because we have invalidated our iterators now
-                return invoke_message_from_cache();
-            }
-        }
-        return false;
+        return super::invoke_message_from_cache(bhvr, mid);
     }
 
 };
@@ -243,29 +248,14 @@ class proper_actor<Base, Policies,true> : public proper_actor_base<Base,
 
     void dequeue_response(behavior& bhvr, message_id mid) override {
         // try to dequeue from cache first
-        if (!this->cache_empty()) {
-            std::vector<unique_mailbox_element_pointer> tmp_vec;
-            auto restore_cache = [&] {
-                if (!tmp_vec.empty()) {
-                    this->cache_prepend(tmp_vec.begin(), tmp_vec.end());
-                }
-            };
-            while (!this->cache_empty()) {
-                auto tmp = this->cache_take_first();
-                if (this->invoke_message(tmp, bhvr, mid)) {
-                    restore_cache();
-                    return;
-                }
-                else tmp_vec.push_back(std::move(tmp));
-            }
-            restore_cache();
-        }
+        if (this->invoke_message_from_cache(bhvr, mid)) return;
         bool has_timeout = false;
         std::uint32_t timeout_id;
+        std::uint64_t timeout_token = 0;
         // request timeout if needed
         if (bhvr.timeout().valid()) {
             has_timeout = true;
-            timeout_id = this->request_timeout(bhvr.timeout());
+            timeout_id = this->request_timeout(bhvr.timeout(), timeout_token);
         }
         // workaround for GCC 4.7 bug (const this when capturing refs)
         auto& pending_timeouts = m_pending_timeouts;
@@ -273,7 +263,13 @@ class proper_actor<Base, Policies,true> : public proper_actor_base<Base,
             if (has_timeout) {
                 auto e = pending_timeouts.end();
                 auto i = std::find(pending_timeouts.begin(), e, timeout_id);
-                if (i != e) pending_timeouts.erase(i);
+                if (i != e) {
+                    // timeout did not fire, withdraw it
+                    pending_timeouts.erase(i);
+                    if (timeout_token != 0) {
+                        this->cancel_delayed_send(timeout_token);
+                    }
+                }
             }
         });
         // read incoming messages
@@ -292,7 +288,10 @@ class proper_actor<Base, Policies,true> : public proper_actor_base<Base,
 
     // timeout handling
 
-    std::uint32_t request_timeout(const util::duration& d) {
+    // stores a token for cancel_delayed_send in @p token
+    // unless the timeout message was enqueued immediately
+    std::uint32_t request_timeout(const util::duration& d,
+                                  std::uint64_t& token) {
         CPPA_REQUIRE(d.valid());
         auto tid = ++m_next_timeout_id;
         auto msg = make_any_tuple(timeout_msg{tid});
@@ -302,7 +301,8 @@ class proper_actor<Base, Policies,true> : public proper_actor_base<Base,
             //auto e = this->new_mailbox_element(this, std::move(msg));
             //this->m_mailbox.enqueue(e);
         }
-        else this->delayed_send_tuple(this, d, std::move(msg));
+        else token = this->cancellable_delayed_send_tuple(this, d,
+                                                          std::move(msg));
         m_pending_timeouts.push_back(tid);
         return tid;
     }
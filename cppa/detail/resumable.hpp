@@ -31,6 +31,8 @@
 #ifndef CPPA_RESUMABLE_HPP
 #define CPPA_RESUMABLE_HPP
 
+#include <atomic>
+
 namespace cppa {
 namespace detail {
 
@@ -42,12 +44,15 @@ class resumable {
 
     enum resume_result {
         resume_later,
+        // the job used up its throughput budget while still having work
+        // left and must be re-enqueued by the caller
+        reschedule,
         done
     };
 
-    // intrusive next pointer needed to use
-    // 'resumable' with 'single_reader_queue'
-    resumable* next;
+    // intrusive next pointer needed to use 'resumable'
+    // with 'intrusive::producer_consumer_list'
+    std::atomic<resumable*> next;
 
     virtual ~resumable();
 
@@ -35,9 +35,10 @@
 
 #include "cppa/scheduler.hpp"
 
-#include "cppa/util/producer_consumer_list.hpp"
+#include "cppa/intrusive/producer_consumer_list.hpp"
 
 #include "cppa/detail/resumable.hpp"
+#include "cppa/detail/idle_strategy.hpp"
 
 namespace cppa { namespace detail {
 
@@ -57,7 +58,9 @@ class thread_pool_scheduler : public scheduler {
 
     thread_pool_scheduler();
 
-    thread_pool_scheduler(size_t num_worker_threads);
+    thread_pool_scheduler(size_t num_worker_threads,
+                          const idle_strategy::settings& idle_settings
+                          = idle_strategy::settings{});
 
     void initialize();
 
@@ -65,18 +68,31 @@ class thread_pool_scheduler : public scheduler {
 
     void enqueue(resumable* what) override;
 
+    /**
+     * @brief Returns the number of worker threads, i.e., each
+     *        worker gets its own timer for delayed messages.
+     */
+    size_t num_timers() const override;
+
+    /**
+     * @brief Returns the spin, park and wakeup counters of all workers.
+     */
+    inline idle_strategy::statistics idle_statistics() const {
+        return m_idle.stats();
+    }
+
  private:
 
-    //typedef util::single_reader_queue<abstract_scheduled_actor> job_queue;
-    typedef util::producer_consumer_list<resumable> job_queue;
+    typedef intrusive::producer_consumer_list<resumable> job_queue;
 
     size_t m_num_threads;
     job_queue m_queue;
     dummy m_dummy;
+    idle_strategy m_idle;
     std::thread m_supervisor;
 
     static void worker_loop(worker*);
-    static void supervisor_loop(job_queue*, resumable*, size_t);
+    static void supervisor_loop(job_queue*, resumable*, idle_strategy*, size_t);
 
 };
 
@@ -0,0 +1,367 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_TIMING_WHEEL_HPP
+#define CPPA_TIMING_WHEEL_HPP
+
+#include <chrono>
+#include <limits>
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+
+namespace cppa { namespace detail {
+
+/**
+ * @brief A hierarchical timing wheel storing values of type @p T
+ *        until their deadline expires.
+ *
+ * Time is divided into ticks of a fixed resolution. The wheel consists of
+ * four levels with 256 slots each; level @p n covers <tt>256^(n+1)</tt>
+ * ticks. Entries are stored in the slot of the lowest level covering their
+ * deadline and move down one level whenever the lower level wraps around.
+ * Hence, both {@link add} and {@link cancel} run in constant time.
+ * Deadlines beyond the range of the highest level are clamped to it
+ * and re-inserted when their slot expires.
+ *
+ * A timing wheel never fires early, but may fire up to one tick late.
+ * It is not thread-safe.
+ */
+template<typename T>
+class timing_wheel {
+
+    struct link {
+        link* prev;
+        link* next;
+    };
+
+    static constexpr size_t bits_per_level = 8;
+
+    static constexpr size_t num_levels = 4;
+
+    static constexpr size_t num_slots = size_t{1} << bits_per_level;
+
+    static constexpr std::uint64_t slot_mask = num_slots - 1;
+
+    // number of entries kept for re-use after they were fired or cancelled
+    static constexpr size_t max_cached_entries = 1024;
+
+ public:
+
+    typedef std::chrono::high_resolution_clock clock_type;
+
+    typedef clock_type::time_point time_point;
+
+    typedef clock_type::duration duration;
+
+    /**
+     * @brief A handle to an entry of the wheel, valid
+     *        until it is fired or cancelled.
+     */
+    class entry : link {
+
+        friend class timing_wheel;
+
+        inline T& value() {
+            return *reinterpret_cast<T*>(&m_storage);
+        }
+
+        std::uint64_t m_tick;
+        size_t m_level;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type m_storage;
+
+    };
+
+    timing_wheel(duration resolution, time_point now = clock_type::now())
+    : m_resolution(resolution), m_epoch(now), m_tick(0), m_size(0)
+    , m_free(nullptr), m_num_free(0) {
+        for (auto& level : m_slots) {
+            for (auto& head : level) head.prev = head.next = &head;
+        }
+        for (auto& n : m_level_size) n = 0;
+    }
+
+    timing_wheel(const timing_wheel&) = delete;
+
+    timing_wheel& operator=(const timing_wheel&) = delete;
+
+    ~timing_wheel() {
+        for (auto& level : m_slots) {
+            for (auto& head : level) {
+                while (head.next != &head) {
+                    auto e = static_cast<entry*>(head.next);
+                    unlink(e);
+                    release(e);
+                }
+            }
+        }
+        while (m_free) {
+            auto e = m_free;
+            m_free = static_cast<entry*>(e->next);
+            delete e;
+        }
+    }
+
+    /**
+     * @brief Returns the duration of a single tick.
+     */
+    inline duration resolution() const {
+        return m_resolution;
+    }
+
+    /**
+     * @brief Returns the number of pending entries.
+     */
+    inline size_t size() const {
+        return m_size;
+    }
+
+    inline bool empty() const {
+        return m_size == 0;
+    }
+
+    /**
+     * @brief Stores @p value until @p deadline expires.
+     * @returns A handle for {@link cancel}.
+     */
+    entry* add(const time_point& deadline, T value) {
+        entry* e;
+        if (m_free) {
+            e = m_free;
+            m_free = static_cast<entry*>(e->next);
+            --m_num_free;
+        }
+        else e = new entry;
+        new (&e->m_storage) T(std::move(value));
+        // round up, because entries must not fire early
+        e->m_tick = 0;
+        if (deadline > m_epoch) {
+            auto rel = deadline - m_epoch;
+            e->m_tick = static_cast<std::uint64_t>(rel / m_resolution);
+            if (rel % m_resolution != duration::zero()) ++e->m_tick;
+        }
+        insert(e);
+        ++m_size;
+        return e;
+    }
+
+    /**
+     * @brief Removes @p e from the wheel without firing it.
+     * @pre @p e was returned by {@link add} and has neither
+     *      been fired nor cancelled.
+     */
+    void cancel(entry* e) {
+        unlink(e);
+        --m_size;
+        release(e);
+    }
+
+    /**
+     * @brief Invokes @p f for each entry with a deadline
+     *        up to @p now in order of their deadline.
+     * @returns The number of fired entries.
+     */
+    template<typename F>
+    size_t advance(const time_point& now, F f) {
+        if (now < m_epoch) return 0;
+        auto last = static_cast<std::uint64_t>((now - m_epoch) / m_resolution);
+        if (m_size == 0) {
+            // nothing to cascade or to fire, skip elapsed ticks
+            if (last >= m_tick) m_tick = last + 1;
+            return 0;
+        }
+        size_t fired = 0;
+        while (m_tick <= last && m_size > 0) {
+            auto level = lowest_level();
+            if (level > 0) {
+                // all lower levels are empty, skip to the next
+                // tick that moves entries down from this level
+                auto next = next_round(level);
+                if (next > m_tick) {
+                    m_tick = std::min(next, last + 1);
+                    continue;
+                }
+            }
+            fired += process(f);
+        }
+        if (m_size == 0 && last >= m_tick) m_tick = last + 1;
+        return fired;
+    }
+
+    /**
+     * @brief Returns the point in time the wheel needs to {@link advance}
+     *        next, or <tt>time_point::max()</tt> if the wheel is empty.
+     *
+     * The result is exact for entries on the lowest level. Otherwise,
+     * it is the next time entries move down to a lower level.
+     */
+    time_point next_timeout() const {
+        if (m_size == 0) return time_point::max();
+        auto next = std::numeric_limits<std::uint64_t>::max();
+        if (m_level_size[0] > 0) {
+            for (std::uint64_t t = m_tick; t < m_tick + num_slots; ++t) {
+                auto& head = m_slots[0][t & slot_mask];
+                if (head.next != &head) {
+                    next = t;
+                    break;
+                }
+            }
+        }
+        if (m_size > m_level_size[0]) {
+            size_t level = 1;
+            while (m_level_size[level] == 0) ++level;
+            auto cascade = next_round(level);
+            if (cascade < next) next = cascade;
+        }
+        return m_epoch + m_resolution * static_cast<duration::rep>(next);
+    }
+
+ private:
+
+    static inline void push_back(link& head, entry* e) {
+        e->prev = head.prev;
+        e->next = &head;
+        head.prev->next = e;
+        head.prev = e;
+    }
+
+    // moves all elements of @p from to @p to
+    static inline void splice(link& from, link& to) {
+        if (from.next == &from) {
+            to.prev = to.next = &to;
+            return;
+        }
+        to.next = from.next;
+        to.prev = from.prev;
+        to.next->prev = &to;
+        to.prev->next = &to;
+        from.prev = from.next = &from;
+    }
+
+    // returns the lowest level with at least one entry
+    inline size_t lowest_level() const {
+        size_t level = 0;
+        while (m_level_size[level] == 0) ++level;
+        return level;
+    }
+
+    // returns the first tick >= m_tick that starts a new
+    // round on all levels below @p level
+    inline std::uint64_t next_round(size_t level) const {
+        auto mask = (std::uint64_t{1} << (bits_per_level * level)) - 1;
+        return (m_tick + mask) & ~mask;
+    }
+
+    inline void unlink(entry* e) {
+        e->prev->next = e->next;
+        e->next->prev = e->prev;
+        --m_level_size[e->m_level];
+    }
+
+    void insert(entry* e) {
+        auto tick = e->m_tick < m_tick ? m_tick : e->m_tick;
+        auto delta = tick - m_tick;
+        size_t level = 0;
+        while (   level + 1 < num_levels
+               && delta >= (std::uint64_t{1} << (bits_per_level * (level + 1)))) {
+            ++level;
+        }
+        auto range = std::uint64_t{1} << (bits_per_level * num_levels);
+        if (delta >= range) tick = m_tick + range - 1;
+        auto slot = (tick >> (bits_per_level * level)) & slot_mask;
+        e->m_level = level;
+        ++m_level_size[level];
+        push_back(m_slots[level][slot], e);
+    }
+
+    void release(entry* e) {
+        e->value().~T();
+        if (m_num_free < max_cached_entries) {
+            e->next = m_free;
+            m_free = e;
+            ++m_num_free;
+        }
+        else delete e;
+    }
+
+    // re-inserts all entries of a slot after a lower level wrapped around
+    void cascade(size_t level, std::uint64_t slot) {
+        link tmp;
+        splice(m_slots[level][slot], tmp);
+        while (tmp.next != &tmp) {
+            auto e = static_cast<entry*>(tmp.next);
+            unlink(e);
+            insert(e);
+        }
+    }
+
+    // processes tick m_tick and increments m_tick
+    template<typename F>
+    size_t process(F& f) {
+        auto tick = m_tick;
+        if ((tick & slot_mask) == 0) {
+            for (size_t level = 1; level < num_levels; ++level) {
+                auto slot = (tick >> (bits_per_level * level)) & slot_mask;
+                cascade(level, slot);
+                if (slot != 0) break;
+            }
+        }
+        link due;
+        splice(m_slots[0][tick & slot_mask], due);
+        // entries added by f must not end up in the slot we are processing
+        ++m_tick;
+        size_t fired = 0;
+        while (due.next != &due) {
+            auto e = static_cast<entry*>(due.next);
+            unlink(e);
+            --m_size;
+            f(e->value());
+            release(e);
+            ++fired;
+        }
+        return fired;
+    }
+
+    duration m_resolution;
+    time_point m_epoch;
+    std::uint64_t m_tick; // next tick to process
+    size_t m_size;
+    size_t m_level_size[num_levels];
+    link m_slots[num_levels][num_slots];
+    entry* m_free;
+    size_t m_num_free;
+
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_TIMING_WHEEL_HPP
@@ -0,0 +1,126 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_WORK_STEALING_SCHEDULER_HPP
+#define CPPA_WORK_STEALING_SCHEDULER_HPP
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "cppa/scheduler.hpp"
+
+#include "cppa/intrusive/producer_consumer_list.hpp"
+
+#include "cppa/detail/resumable.hpp"
+#include "cppa/detail/cpu_topology.hpp"
+#include "cppa/detail/idle_strategy.hpp"
+
+namespace cppa { namespace detail {
+
+struct cs_thread;
+
+/**
+ * @brief A scheduler using one job deque per worker thread.
+ *
+ * Jobs enqueued by a worker (e.g., an actor waking up another actor) are
+ * pushed to the worker's own deque and dequeued in LIFO order.
+ * Jobs enqueued by any other thread go to a shared queue. Idle workers
+ * steal the oldest job of a randomly chosen victim.
+ *
+ * If workers are pinned, each worker is bound to one CPU and workers are
+ * distributed round-robin over the NUMA nodes of the host. Each node has
+ * its own shared queue, and threads outside of the scheduler enqueue to the
+ * queue of the node they are currently running on. Idle workers prefer
+ * jobs of their own node and steal from other nodes only as last resort.
+ */
+class work_stealing_scheduler : public scheduler {
+
+    typedef scheduler super;
+
+ public:
+
+    struct dummy : resumable {
+        resume_result resume(detail::cs_thread*) override;
+    };
+
+    class worker;
+
+    work_stealing_scheduler();
+
+    work_stealing_scheduler(size_t num_worker_threads,
+                            const idle_strategy::settings& idle_settings
+                            = idle_strategy::settings{},
+                            bool pin_workers = false);
+
+    ~work_stealing_scheduler();
+
+    void initialize();
+
+    void destroy();
+
+    void enqueue(resumable* what) override;
+
+    /**
+     * @brief Returns the number of worker threads, i.e., each
+     *        worker gets its own timer for delayed messages.
+     */
+    size_t num_timers() const override;
+
+    /**
+     * @brief Returns the spin, park and wakeup counters of all workers.
+     */
+    inline idle_strategy::statistics idle_statistics() const {
+        return m_idle.stats();
+    }
+
+ private:
+
+    typedef intrusive::producer_consumer_list<resumable> job_queue;
+
+    size_t m_num_threads;
+    bool m_pin_workers;
+    cpu_topology m_topology;
+    // one shared queue per NUMA node
+    std::vector<std::unique_ptr<job_queue>> m_queues;
+    dummy m_dummy;
+    idle_strategy m_idle;
+    std::vector<std::unique_ptr<worker>> m_workers;
+    std::thread m_supervisor;
+
+    static void worker_loop(worker*);
+    static void supervisor_loop(work_stealing_scheduler*);
+
+};
+
+} } // namespace cppa::detail
+
+#endif // CPPA_WORK_STEALING_SCHEDULER_HPP
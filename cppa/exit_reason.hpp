@@ -82,6 +82,13 @@ static constexpr std::uint32_t user_shutdown = 0x00010;
  */
 static constexpr std::uint32_t remote_link_unreachable = 0x00101;
 
+/**
+ * @brief Indicates that a synchronous request was bounced
+ *        because the outbound queue to the receiving node
+ *        exceeded its high watermark.
+ */
+static constexpr std::uint32_t remote_overloaded = 0x00102;
+
 /**
  * @brief Any user defined exit reason should have a
  *        value greater or equal to prevent collisions
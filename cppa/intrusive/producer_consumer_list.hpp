@@ -0,0 +1,132 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_INTRUSIVE_PRODUCER_CONSUMER_LIST_HPP
+#define CPPA_INTRUSIVE_PRODUCER_CONSUMER_LIST_HPP
+
+#include <atomic>
+#include <thread>
+
+#include "cppa/config.hpp"
+
+namespace cppa { namespace intrusive {
+
+/**
+ * @brief An intrusive, thread safe queue for multiple producers and
+ *        multiple consumers.
+ *
+ * Elements are linked through their member <tt>std::atomic<T*> next</tt>,
+ * i.e., unlike {@link util::producer_consumer_list}, this queue does not
+ * allocate any memory. Producers never block: appending an element is a
+ * single atomic exchange on the tail. Consumers are serialized
+ * using a spinlock.
+ * @warning An element must not be enqueued again before it was dequeued.
+ *          The queue does not take ownership of its elements.
+ */
+template<typename T>
+class producer_consumer_list {
+
+ public:
+
+    typedef T           value_type;
+    typedef value_type* pointer;
+
+    producer_consumer_list() : m_head(nullptr), m_consumer_lock(false) {
+        m_tail = &m_head;
+    }
+
+    producer_consumer_list(const producer_consumer_list&) = delete;
+
+    producer_consumer_list& operator=(const producer_consumer_list&) = delete;
+
+    inline void push_back(pointer value) {
+        CPPA_REQUIRE(value != nullptr);
+        value->next = nullptr;
+        // swing tail to the new element and link its predecessor
+        auto prev = m_tail.exchange(&value->next);
+        prev->store(value);
+    }
+
+    // returns nullptr on failure
+    pointer try_pop() {
+        while (m_consumer_lock.exchange(true)) {
+            std::this_thread::yield();
+        }
+        auto result = take_head();
+        m_consumer_lock = false;
+        return result;
+    }
+
+ private:
+
+    typedef std::atomic<pointer> link;
+
+    static_assert(sizeof(link) < CPPA_CACHE_LINE_SIZE,
+                  "sizeof(std::atomic<T*>) >= CPPA_CACHE_LINE_SIZE");
+
+    // accessed by the consumer holding the lock and by producers
+    // if the queue is empty, i.e., if m_tail points to m_head
+    link m_head;
+    char m_pad1[CPPA_CACHE_LINE_SIZE - sizeof(link)];
+
+    // points to the 'next' member of the last element or to m_head
+    std::atomic<link*> m_tail;
+    char m_pad2[CPPA_CACHE_LINE_SIZE - sizeof(std::atomic<link*>)];
+
+    std::atomic<bool> m_consumer_lock;
+
+    // requires exclusive access to the consumer side
+    pointer take_head() {
+        pointer first = m_head;
+        if (first == nullptr) return nullptr;
+        pointer next = first->next;
+        if (next == nullptr) {
+            // first might be the last element: try to reset tail to m_head
+            m_head = nullptr;
+            auto expected = &first->next;
+            if (!m_tail.compare_exchange_strong(expected, &m_head)) {
+                // a producer swung tail forward but did not link
+                // its element yet; this happens between two instructions
+                while ((next = first->next) == nullptr) {
+                    std::this_thread::yield();
+                }
+                m_head = next;
+            }
+        }
+        else m_head = next;
+        return first;
+    }
+
+};
+
+} } // namespace cppa::intrusive
+
+#endif // CPPA_INTRUSIVE_PRODUCER_CONSUMER_LIST_HPP
@@ -32,8 +32,10 @@
 #define CPPA_SINGLE_READER_QUEUE_HPP
 
 #include <list>
+#include <limits>
 #include <atomic>
 #include <memory>
+#include <cstddef>
 
 #include "cppa/config.hpp"
 
@@ -61,6 +63,29 @@ class single_reader_queue {
         return take_head();
     }
 
+    /**
+     * @brief Removes up to @p max_elements elements in FIFO order and
+     *        passes ownership of each one to @p f. Elements enqueued
+     *        concurrently are fetched with a single atomic operation.
+     * @returns The number of elements passed to @p f.
+     * @warning call only from the reader (owner)
+     */
+    template<typename F>
+    size_t drain(F f, size_t max_elements = std::numeric_limits<size_t>::max()) {
+        size_t result = 0;
+        for (bool fetched = false; result < max_elements; ) {
+            if (m_head == nullptr) {
+                if (fetched || !fetch_new_data()) return result;
+                fetched = true;
+            }
+            auto e = m_head;
+            m_head = m_head->next;
+            f(e);
+            ++result;
+        }
+        return result;
+    }
+
     template<class UnaryPredicate>
     void remove_if(UnaryPredicate f) {
         pointer head = m_head;
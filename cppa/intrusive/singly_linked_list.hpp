@@ -0,0 +1,220 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_SINGLY_LINKED_LIST_HPP
+#define CPPA_SINGLY_LINKED_LIST_HPP
+
+#include <memory>
+#include <cstddef>
+#include <iterator>
+
+#include "cppa/config.hpp"
+
+namespace cppa { namespace intrusive {
+
+/**
+ * @brief An intrusive, owning singly linked list with O(1) insertion and
+ *        removal at any iterator position.
+ *
+ * Iterators refer to the link pointing to an element rather than to the
+ * element itself. Hence, removing the element an iterator refers to
+ * lets the iterator refer to the successor and only invalidates
+ * iterators referring to the successor of the removed element.
+ * @warning This container is not thread safe.
+ */
+template<typename T, class Delete = std::default_delete<T> >
+class singly_linked_list {
+
+ public:
+
+    typedef T           value_type;
+    typedef value_type* pointer;
+
+    class iterator {
+
+        friend class singly_linked_list;
+
+     public:
+
+        typedef std::forward_iterator_tag iterator_category;
+        typedef T*                        value_type;
+        typedef std::ptrdiff_t            difference_type;
+        typedef T* const*                 pointer;
+        typedef T* const&                 reference;
+
+        inline iterator(T** link = nullptr) : m_link(link) { }
+
+        inline T* operator*() const {
+            return get();
+        }
+
+        inline T* operator->() const {
+            return get();
+        }
+
+        inline iterator& operator++() {
+            m_link = &((*m_link)->next);
+            return *this;
+        }
+
+        inline iterator operator++(int) {
+            iterator tmp{*this};
+            ++*this;
+            return tmp;
+        }
+
+        // two iterators are equal if they refer to the same element
+        inline bool operator==(const iterator& other) const {
+            return get() == other.get();
+        }
+
+        inline bool operator!=(const iterator& other) const {
+            return get() != other.get();
+        }
+
+     private:
+
+        inline T* get() const {
+            return m_link ? *m_link : nullptr;
+        }
+
+        T** m_link;
+
+    };
+
+    inline singly_linked_list() : m_head(nullptr), m_tail(&m_head), m_size(0) { }
+
+    singly_linked_list(const singly_linked_list&) = delete;
+    singly_linked_list& operator=(const singly_linked_list&) = delete;
+
+    inline ~singly_linked_list() { clear(); }
+
+    inline iterator begin() {
+        return &m_head;
+    }
+
+    inline iterator end() {
+        return {};
+    }
+
+    inline bool empty() const {
+        return m_head == nullptr;
+    }
+
+    inline size_t size() const {
+        return m_size;
+    }
+
+    inline pointer front() {
+        return m_head;
+    }
+
+    void push_back(pointer what) {
+        CPPA_REQUIRE(what != nullptr);
+        what->next = nullptr;
+        *m_tail = what;
+        m_tail = &(what->next);
+        ++m_size;
+    }
+
+    inline void push_front(pointer what) {
+        insert(begin(), what);
+    }
+
+    /**
+     * @brief Inserts @p what before @p pos; @p pos refers
+     *        to @p what afterwards.
+     */
+    iterator insert(iterator pos, pointer what) {
+        CPPA_REQUIRE(what != nullptr);
+        if (pos.m_link == nullptr) {
+            auto link = m_tail;
+            push_back(what);
+            return link;
+        }
+        what->next = *pos.m_link;
+        if (what->next == nullptr) m_tail = &(what->next);
+        *pos.m_link = what;
+        ++m_size;
+        return pos;
+    }
+
+    /**
+     * @brief Removes the element at @p pos from the list without deleting
+     *        it; @p pos refers to the successor of the removed element
+     *        afterwards.
+     * @pre <tt>pos != end()</tt>
+     */
+    pointer take(iterator pos) {
+        CPPA_REQUIRE(pos != end());
+        auto result = *pos.m_link;
+        *pos.m_link = result->next;
+        if (result->next == nullptr) m_tail = pos.m_link;
+        result->next = nullptr;
+        --m_size;
+        return result;
+    }
+
+    inline pointer take_front() {
+        return empty() ? nullptr : take(begin());
+    }
+
+    /**
+     * @brief Removes and deletes the element at @p pos.
+     * @returns An iterator referring to the successor of the removed element.
+     */
+    inline iterator erase(iterator pos) {
+        m_delete(take(pos));
+        return pos;
+    }
+
+    void clear() {
+        while (m_head != nullptr) {
+            auto next = m_head->next;
+            m_delete(m_head);
+            m_head = next;
+        }
+        m_tail = &m_head;
+        m_size = 0;
+    }
+
+ private:
+
+    pointer  m_head;
+    pointer* m_tail;
+    size_t   m_size;
+    Delete   m_delete;
+
+};
+
+} } // namespace cppa::intrusive
+
+#endif // CPPA_SINGLY_LINKED_LIST_HPP
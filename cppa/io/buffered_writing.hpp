@@ -31,6 +31,7 @@
 #ifndef CPPA_IO_BUFFERED_WRITING_HPP
 #define CPPA_IO_BUFFERED_WRITING_HPP
 
+#include <deque>
 #include <utility>
 
 #include "cppa/util/buffer.hpp"
@@ -41,39 +42,74 @@
 
 namespace cppa { namespace io {
 
+/**
+ * @brief Mixin adding an output buffer to a {@link continuable} that is
+ *        flushed whenever the underlying stream becomes writable.
+ *
+ * Pending data is kept in a chain of segments. Consecutive writes are
+ * coalesced into the last segment until it reaches the cork threshold,
+ * at which point a new segment is started. All segments are flushed using
+ * a single gathered write and partially written data is consumed by
+ * advancing an offset into the first segment rather than moving memory.
+ */
 template<class Base, class Subtype>
 class buffered_writing : public Base {
 
     typedef Base super;
 
+    // maximum number of segments passed to a single write_gathered() call
+    static constexpr size_t max_slices_per_write = 64;
+
  public:
 
+    /**
+     * @brief The default value for {@link cork_threshold()}.
+     */
+    static constexpr size_t default_cork_threshold = 16 * 1024;
+
     template<typename... Ts>
     buffered_writing(middleman* mm, output_stream_ptr out, Ts&&... args)
     : super{std::forward<Ts>(args)...}, m_parent{mm}, m_out{out}
-    , m_has_unwritten_data{false} { }
+    , m_has_unwritten_data{false}, m_offset{0}
+    , m_cork_threshold{default_cork_threshold} { }
 
     continue_writing_result continue_writing() override {
         CPPA_LOG_TRACE("");
         CPPA_LOG_DEBUG_IF(!m_has_unwritten_data, "nothing to write (done)");
+        output_slice slices[max_slices_per_write];
         while (m_has_unwritten_data) {
+            size_t num_slices = 0;
+            size_t requested = 0;
+            auto offset = m_offset;
+            for (auto i = m_segments.begin();
+                 i != m_segments.end() && num_slices < max_slices_per_write;
+                 ++i) {
+                if (i->size() > offset) {
+                    slices[num_slices].data = i->offset_data(offset);
+                    slices[num_slices].size = i->size() - offset;
+                    requested += slices[num_slices].size;
+                    ++num_slices;
+                }
+                offset = 0;
+            }
             size_t written;
-            try { written = m_out->write_some(m_buf.data(), m_buf.size()); }
+            try { written = m_out->write_gathered(slices, num_slices); }
             catch (std::exception& e) {
                 CPPA_LOG_ERROR(to_verbose_string(e));
                 static_cast<void>(e); // keep compiler happy
                 return write_failure;
             }
-            if (written != m_buf.size()) {
-                CPPA_LOG_DEBUG("tried to write " << m_buf.size() << "bytes, "
+            consume(written);
+            if (written != requested) {
+                CPPA_LOG_DEBUG("tried to write " << requested << "bytes, "
                                << "only " << written << " bytes written");
-                m_buf.erase_leading(written);
                 return write_continue_later;
             }
-            else {
-                m_buf.clear();
+            CPPA_LOG_DEBUG(written << " bytes written");
+            if (m_segments.empty()
+                    || (m_segments.size() == 1 && m_segments.front().empty())) {
                 m_has_unwritten_data = false;
-                CPPA_LOG_DEBUG("write done, " << written << " bytes written");
+                CPPA_LOG_DEBUG("write done");
             }
         }
         return write_done;
@@ -83,8 +119,17 @@ class buffered_writing : public Base {
         return m_has_unwritten_data;
     }
 
+    /**
+     * @brief Returns the number of bytes not yet written to the stream.
+     */
+    size_t unwritten_bytes() const {
+        size_t result = 0;
+        for (auto& segment : m_segments) result += segment.size();
+        return result - m_offset;
+    }
+
     void write(size_t num_bytes, const void* data) {
-        m_buf.write(num_bytes, data);
+        write_buffer().write(num_bytes, data);
         register_for_writing();
     }
 
@@ -92,12 +137,22 @@ class buffered_writing : public Base {
         write(buf.size(), buf.data());
     }
 
+    /**
+     * @brief Appends @p buf to the output buffer. Buffers that exceed
+     *        the cork threshold are moved into a segment of their own
+     *        rather than being copied.
+     */
     void write(util::buffer&& buf) {
-        if (m_buf.empty()) m_buf = std::move(buf);
-        else {
-            m_buf.write(buf.size(), buf.data());
+        if (buf.size() < m_cork_threshold) {
+            write_buffer().write(buf.size(), buf.data());
             buf.clear();
         }
+        else {
+            if (!m_segments.empty() && m_segments.back().empty()) {
+                m_segments.back() = std::move(buf);
+            }
+            else m_segments.push_back(std::move(buf));
+        }
         register_for_writing();
     }
 
@@ -109,8 +164,32 @@ class buffered_writing : public Base {
         }
     }
 
+    /**
+     * @brief Returns the segment new data is appended to. The returned
+     *        reference stays valid until the next call to this member
+     *        function or to write().
+     */
     inline util::buffer& write_buffer() {
-        return m_buf;
+        if (m_segments.empty() || m_segments.back().size() >= m_cork_threshold) {
+            m_segments.emplace_back();
+        }
+        return m_segments.back();
+    }
+
+    /**
+     * @brief Returns the number of bytes up to which consecutive writes
+     *        are coalesced into a single segment.
+     */
+    inline size_t cork_threshold() const {
+        return m_cork_threshold;
+    }
+
+    /**
+     * @brief Sets the number of bytes up to which consecutive writes
+     *        are coalesced into a single segment.
+     */
+    inline void cork_threshold(size_t new_value) {
+        m_cork_threshold = new_value;
     }
 
  protected:
@@ -123,10 +202,33 @@ class buffered_writing : public Base {
 
  private:
 
+    // drops @p num_bytes bytes from the front of the segment chain;
+    // the last segment is kept to reuse its memory
+    void consume(size_t num_bytes) {
+        while (!m_segments.empty()
+               && (num_bytes > 0 || m_segments.front().size() == m_offset)) {
+            auto& front = m_segments.front();
+            auto remaining = front.size() - m_offset;
+            if (num_bytes < remaining) {
+                m_offset += num_bytes;
+                return;
+            }
+            num_bytes -= remaining;
+            m_offset = 0;
+            if (m_segments.size() == 1) {
+                front.clear();
+                return;
+            }
+            m_segments.pop_front();
+        }
+    }
+
     middleman* m_parent;
     output_stream_ptr m_out;
     bool m_has_unwritten_data;
-    util::buffer m_buf;
+    std::deque<util::buffer> m_segments;
+    size_t m_offset; // number of already written bytes in m_segments.front()
+    size_t m_cork_threshold;
 
 };
 
@@ -94,11 +94,16 @@ class continuable {
 
     /**
      * @brief Reads from {@link read_handle()} if valid.
+     * @note Implementations must read until the socket would block
+     *       before returning @p read_continue_later, because the
+     *       event loop may run in edge-triggered mode.
      */
     virtual continue_reading_result continue_reading();
 
     /**
      * @brief Writes to {@link write_handle()} if valid.
+     * @note Implementations must write until the socket would block
+     *       before returning @p write_continue_later.
      */
     virtual continue_writing_result continue_writing();
 
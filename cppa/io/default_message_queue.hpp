@@ -31,36 +31,277 @@
 #ifndef CPPA_MESSAGE_QUEUE_HPP
 #define CPPA_MESSAGE_QUEUE_HPP
 
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+#include <utility>
+
+#include "cppa/extend.hpp"
 #include "cppa/any_tuple.hpp"
+#include "cppa/actor_addr.hpp"
 #include "cppa/ref_counted.hpp"
+#include "cppa/memory_cached.hpp"
+#include "cppa/memory_managed.hpp"
+#include "cppa/wire_format.hpp"
 #include "cppa/message_header.hpp"
+#include "cppa/type_lookup_table.hpp"
+
+#include "cppa/util/buffer.hpp"
+
+#include "cppa/detail/memory.hpp"
+
+#include "cppa/intrusive/single_reader_queue.hpp"
+
+namespace cppa { class actor_namespace; }
 
 namespace cppa { namespace io {
 
+/**
+ * @brief Selects how the outbound queue of a peer handles
+ *        messages once it exceeded its high watermark.
+ */
+enum class overflow_policy : std::uint32_t {
+    /**
+     * @brief Drops asynchronous messages with normal priority.
+     */
+    drop_low_priority,
+    /**
+     * @brief Bounces synchronous requests, i.e., the sender receives
+     *        a {@link sync_exited_msg} with reason
+     *        {@link exit_reason::remote_overloaded}.
+     */
+    bounce_requests
+};
+
+/**
+ * @brief The outbound queue of a peer. Any thread can enqueue messages,
+ *        but only the event loop serving the peer dequeues them.
+ *
+ * Messages are serialized by the enqueueing thread, i.e., the event loop
+ * only receives finished byte segments ready for writing. The queue also
+ * owns the table of type IDs announced to the remote node, either via
+ * @p ADD_TYPE messages or inline when using {@link wire_format::v2}.
+ *
+ * Each message is prefixed by its size as 32 bit integer. The most
+ * significant bit of the prefix marks messages encoded in wire format v2,
+ * the second most significant bit marks compressed messages. The payload
+ * of a compressed message is the size of the uncompressed payload as
+ * 32 bit integer followed by a single LZ4 block.
+ *
+ * Flow control is based on the number of pending bytes, i.e., bytes in
+ * the queue plus bytes in the output buffer of the peer. Once the pending
+ * bytes reach the high watermark, the queue is considered overloaded and
+ * {@link admit()} applies the overflow policy until the pending bytes
+ * fall to the low watermark again.
+ */
 class default_message_queue : public ref_counted {
 
  public:
 
-    typedef std::pair<message_header, any_tuple> value_type;
+    /**
+     * @brief Marks a message encoded in {@link wire_format::v2}
+     *        in its size prefix.
+     */
+    static constexpr std::uint32_t v2_flag = 0x80000000;
+
+    /**
+     * @brief Marks a compressed message in its size prefix.
+     */
+    static constexpr std::uint32_t compressed_flag = 0x40000000;
+
+    class element : public extend<memory_managed>::with<memory_cached> {
+
+        friend class detail::memory;
+
+     public:
+
+        element* next;
+        util::buffer buf;
+
+     private:
+
+        element() : next(nullptr) { }
+
+    };
+
+    /**
+     * @brief Creates a queue assigning IDs starting at @p first_type_id
+     *        to types announced to the remote node, unless smaller IDs
+     *        are still unused. Queues sharing a connection must use
+     *        disjoint ranges of type IDs.
+     */
+    default_message_queue(actor_namespace* ns, std::uint32_t first_type_id = 0);
+
+    /**
+     * @brief Serializes and enqueues a message. Returns @p true if the queue
+     *        was empty, i.e., if the middleman needs to be notified.
+     * @note This member function is thread-safe.
+     */
+    bool enqueue(const message_header& hdr, const any_tuple& msg);
+
+    /**
+     * @brief Checks whether a user message with header @p hdr should be
+     *        enqueued. Returns @p false if the message must be dropped or,
+     *        if it is a synchronous request, bounced by the caller.
+     * @note This member function is thread-safe.
+     */
+    bool admit(const message_header& hdr);
+
+    /**
+     * @brief Sets the watermarks for the number of pending bytes
+     *        and the policy applied once the queue is overloaded.
+     * @param high A value of 0 disables flow control.
+     * @note This member function is thread-safe.
+     */
+    void watermarks(size_t low, size_t high, overflow_policy policy);
+
+    inline size_t low_watermark() const { return m_low_watermark; }
+
+    inline size_t high_watermark() const { return m_high_watermark; }
+
+    inline overflow_policy policy() const { return m_policy; }
+
+    /**
+     * @brief Returns whether the pending bytes reached the high watermark
+     *        and did not yet fall back to the low watermark.
+     */
+    inline bool overloaded() const { return m_overloaded; }
 
-    typedef value_type& reference;
+    /**
+     * @brief Returns the number of messages in the queue, i.e.,
+     *        not yet moved to the output buffer of the peer.
+     */
+    inline size_t queued_messages() const { return m_queued_messages; }
 
-    template<typename... Ts>
-    void emplace(Ts&&... args) {
-        m_impl.emplace_back(std::forward<Ts>(args)...);
+    /**
+     * @brief Returns the number of serialized bytes not
+     *        yet written to the network.
+     */
+    inline size_t pending_bytes() const {
+        return m_queued_bytes + m_unwritten_bytes;
     }
 
-    inline bool empty() const { return m_impl.empty(); }
+    /**
+     * @brief Returns the number of messages dropped
+     *        or bounced due to the overflow policy.
+     */
+    inline size_t rejected_messages() const { return m_rejected_messages; }
+
+    /**
+     * @brief Sends @p msg to @p listener once the queue is no longer
+     *        overloaded, i.e., immediately if it currently is not.
+     * @note This member function is thread-safe.
+     */
+    void notify_on_capacity(const actor_addr& listener, any_tuple msg);
+
+    /**
+     * @brief Updates the number of bytes in the output buffer of the peer
+     *        and notifies all listeners if the queue is no longer overloaded.
+     * @warning Call only from the event loop serving the peer.
+     */
+    void unwritten_bytes(size_t num_bytes);
 
-    inline value_type pop() {
-        value_type result(std::move(m_impl.front()));
-        m_impl.erase(m_impl.begin());
+    /**
+     * @brief Encodes all messages enqueued from now on using @p format.
+     *        Called once the remote node has announced support for it.
+     * @note This member function is thread-safe.
+     */
+    void use_wire_format(wire_format format);
+
+    /**
+     * @brief Compresses all messages enqueued from now on if they exceed
+     *        {@link compression_threshold()}. Called once the remote node
+     *        has announced support for compressed messages.
+     * @note This member function is thread-safe.
+     */
+    void enable_compression();
+
+    /**
+     * @brief Passes the serialized form of all enqueued messages in FIFO
+     *        order to @p f, which may move from its argument.
+     *        Messages enqueued after this member function returned
+     *        cause {@link enqueue()} to return @p true again.
+     * @returns The number of segments passed to @p f.
+     * @warning Call only from the event loop serving the peer.
+     */
+    template<typename F>
+    size_t drain(F f) {
+        size_t result = 0;
+        auto g = [&](element* e) {
+            m_queued_bytes -= e->buf.size();
+            --m_queued_messages;
+            f(e->buf);
+            detail::disposer d;
+            d(e);
+        };
+        for (auto n = m_impl.drain(g); n > 0; n = m_impl.drain(g)) {
+            result += n;
+        }
         return result;
     }
 
+    /**
+     * @warning Call only from the event loop serving the peer.
+     */
+    inline bool empty() const { return m_impl.empty(); }
+
  private:
 
-    std::vector<value_type> m_impl;
+    typedef std::shared_ptr<type_lookup_table> type_table_ptr;
+
+    // returns the current (immutable) table of announced types
+    type_table_ptr outgoing_types();
+
+    // serializes a size-prefixed message into @p buf,
+    // returns false if the message was dropped due to an error
+    bool serialize(util::buffer& buf, type_lookup_table* types,
+                   wire_format format, const message_header& hdr,
+                   const any_tuple& msg, bool intern_types = false);
+
+    // replaces the payload of the message starting at @p offset
+    // by its compressed form unless that does not save any space
+    void compress(util::buffer& buf, size_t offset);
+
+    // accounts for and enqueues a serialized message
+    bool push(element* e);
+
+    // marks the queue as overloaded if the high watermark was reached
+    void check_high_watermark();
+
+    // assigns an ID to @p tname and writes the corresponding
+    // ADD_TYPE message to @p buf; requires m_types_mtx to be locked
+    void add_type_if_needed(util::buffer& buf, const std::string& tname);
+
+    actor_namespace* m_namespace;
+
+    std::atomic<wire_format> m_format;
+
+    std::atomic<bool> m_compress;
+
+    // flow control
+    std::atomic<size_t> m_low_watermark;
+    std::atomic<size_t> m_high_watermark;
+    std::atomic<overflow_policy> m_policy;
+    std::atomic<bool> m_overloaded;
+    std::atomic<size_t> m_queued_messages;
+    std::atomic<size_t> m_queued_bytes;
+    std::atomic<size_t> m_unwritten_bytes;
+    std::atomic<size_t> m_rejected_messages;
+
+    // actors waiting for the queue to drain to its low watermark;
+    // m_overloaded is only cleared while holding m_listeners_mtx
+    std::mutex m_listeners_mtx;
+    std::vector<std::pair<actor_addr, any_tuple>> m_listeners;
+
+    // tables are copied on write; m_types_mtx is held until the segment
+    // announcing a new type has been enqueued, because other threads must
+    // not use the new ID before the remote node has learned it
+    std::mutex m_types_mtx;
+    type_table_ptr m_types;
+
+    intrusive::single_reader_queue<element, detail::disposer> m_impl;
 
 };
 
@@ -68,6 +309,4 @@ typedef intrusive_ptr<default_message_queue> default_message_queue_ptr;
 
 } } // namespace cppa::network
 
-
-
 #endif // CPPA_MESSAGE_QUEUE_HPP
@@ -58,6 +58,8 @@ class ipv4_io_stream : public stream {
 
     size_t write_some(const void* buf, size_t len);
 
+    size_t write_gathered(const output_slice* slices, size_t num_slices);
+
  private:
 
     ipv4_io_stream(native_socket_type fd);
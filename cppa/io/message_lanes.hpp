@@ -0,0 +1,154 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_MESSAGE_LANES_HPP
+#define CPPA_MESSAGE_LANES_HPP
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+#include "cppa/abstract_actor.hpp"
+#include "cppa/ref_counted.hpp"
+#include "cppa/message_header.hpp"
+
+#include "cppa/io/default_message_queue.hpp"
+
+namespace cppa { class actor_namespace; }
+
+namespace cppa { namespace io {
+
+/**
+ * @brief The set of outbound queues ("lanes") of a remote node. Each lane
+ *        is served by its own connection, lane 0 is the connection
+ *        established via {@link remote_actor()} or {@link publish()}.
+ *
+ * Messages are assigned to lanes by hashing the IDs of sender and
+ * receiver, i.e., the order of messages between two actors is preserved.
+ * If there is more than one lane, the last lane is reserved for messages
+ * with high priority.
+ *
+ * The number of lanes is fixed for the lifetime of a lane set. Lanes other
+ * than lane 0 are @p pending until both nodes agreed on the lanes via
+ * @p LANES messages. Afterwards, a lane is either @p active, i.e., served
+ * by its own connection, or @p merged, i.e., served by the connection
+ * of lane 0 because the remote node refused or failed to connect it.
+ * Messages are kept in the queue of a pending lane.
+ */
+class message_lanes : public ref_counted {
+
+ public:
+
+    enum lane_state : int {
+        pending,
+        active,
+        merged
+    };
+
+    /**
+     * @brief The maximum number of lanes per node.
+     */
+    static constexpr size_t max_lanes = 32;
+
+    /**
+     * @brief Replaces the process ID in the handshake of connections
+     *        for lanes other than lane 0. The marker is followed by
+     *        process ID, host ID, and lane as 32 bit integer.
+     */
+    static constexpr std::uint32_t handshake_marker = 0xFFFFFFFF;
+
+    /**
+     * @brief The number of type IDs reserved per lane, because the
+     *        queue of a merged lane shares the connection of lane 0.
+     */
+    static constexpr std::uint32_t type_ids_per_lane = 4096;
+
+    message_lanes(actor_namespace* ns, size_t num_lanes);
+
+    inline size_t size() const {
+        return m_queues.size();
+    }
+
+    inline const default_message_queue_ptr& queue(size_t lane) const {
+        return m_queues[lane];
+    }
+
+    /**
+     * @brief Returns the lane of messages from the sender in @p hdr
+     *        to the actor with ID @p receiver.
+     * @note This member function is thread-safe.
+     */
+    size_t select(const message_header& hdr, actor_id receiver) const;
+
+    inline lane_state state(size_t lane) const {
+        return static_cast<lane_state>(m_states[lane].load());
+    }
+
+    /**
+     * @brief Sets the state of @p lane to @p to if it currently is @p from.
+     * @returns @p true if the state was changed, otherwise @p false.
+     */
+    bool transition(size_t lane, lane_state from, lane_state to);
+
+    /**
+     * @brief Returns a bitmask with one bit set per lane.
+     */
+    inline std::uint32_t all() const {
+        return static_cast<std::uint32_t>((std::uint64_t{1} << size()) - 1);
+    }
+
+    /**
+     * @brief The lanes this node offers to the remote node as bitmask,
+     *        or 0 if not known yet.
+     * @warning Accessed only by the event loop serving lane 0.
+     */
+    std::uint32_t local_offer;
+
+    /**
+     * @brief The lanes the remote node offers to this node as bitmask,
+     *        or 0 if not known yet.
+     * @warning Accessed only by the event loop serving lane 0.
+     */
+    std::uint32_t remote_offer;
+
+ private:
+
+    std::vector<default_message_queue_ptr> m_queues;
+    std::unique_ptr<std::atomic<int>[]> m_states;
+
+};
+
+typedef intrusive_ptr<message_lanes> message_lanes_ptr;
+
+} } // namespace cppa::io
+
+#endif // CPPA_MESSAGE_LANES_HPP
@@ -34,12 +34,18 @@
 #include <map>
 #include <vector>
 #include <memory>
-#include <functional>
+#include <utility>
 
+#include "cppa/extend.hpp"
 #include "cppa/node_id.hpp"
 #include "cppa/cppa_fwd.hpp"
+#include "cppa/memory_cached.hpp"
+#include "cppa/memory_managed.hpp"
 #include "cppa/actor_namespace.hpp"
 
+#include "cppa/io/message_lanes.hpp"
+#include "cppa/io/default_message_queue.hpp"
+
 namespace cppa { namespace detail { class singleton_manager; } }
 
 namespace cppa {
@@ -62,10 +68,53 @@ class middleman_event_handler;
 typedef intrusive_ptr<input_stream> input_stream_ptr;
 typedef intrusive_ptr<output_stream> output_stream_ptr;
 
+/**
+ * @brief A function object enqueued to an event loop
+ *        of the middleman via {@link middleman::run_later}.
+ */
+class middleman_event : public extend<memory_managed>::with<memory_cached> {
+
+ public:
+
+    middleman_event* next; // intrusive next pointer
+
+    virtual void run() = 0;
+
+ protected:
+
+    inline middleman_event() : next(nullptr) { }
+
+};
+
+/**
+ * @brief Stores a function object of type @p F inline, i.e.,
+ *        without allocating a @p std::function.
+ */
+template<typename F>
+class middleman_event_impl : public middleman_event {
+
+    friend class detail::memory;
+
+ public:
+
+    void run() override { m_fun(); }
+
+ private:
+
+    middleman_event_impl(F fun) : m_fun(std::move(fun)) { }
+
+    F m_fun;
+
+};
+
 /**
  * @brief Multiplexes asynchronous IO.
+ *
+ * The middleman runs one or more event loops in their own threads,
+ * see {@link middleman_threads()}. Each peer is served by exactly one
+ * loop, which is selected by the peer's node ID.
  * @note No member function except for @p run_later is safe to call from
- *       outside the event loop.
+ *       outside an event loop.
  */
 class middleman {
 
@@ -76,10 +125,23 @@ class middleman {
     virtual ~middleman();
 
     /**
-     * @brief Runs @p fun in the event loop of the middleman.
+     * @brief Runs @p fun in the first event loop of the middleman,
+     *        which also serves all brokers and acceptors.
+     * @note This member function is thread-safe.
+     */
+    template<typename F>
+    inline void run_later(F fun) {
+        enqueue(new_event(std::move(fun)));
+    }
+
+    /**
+     * @brief Runs @p fun in the event loop serving @p node.
      * @note This member function is thread-safe.
      */
-    virtual void run_later(std::function<void()> fun) = 0;
+    template<typename F>
+    inline void run_later(const node_id& node, F fun) {
+        enqueue(node, new_event(std::move(fun)));
+    }
 
     /**
      * @brief Removes @p ptr from the list of active writers.
@@ -116,14 +178,16 @@ class middleman {
     bool has_reader(continuable* ptr);
 
     /**
-     * @brief Tries to register a new peer, i.e., a new node in the network.
-     *        Returns false if there is already a connection to @p node,
-     *        otherwise true.
+     * @brief Tries to register a new peer, i.e., a new node in the network
+     *        or an additional connection to a known node. Returns false if
+     *        there is already a connection to @p node serving the lane of
+     *        @p ptr or if the lane is not pending, otherwise true.
      */
     virtual bool register_peer(const node_id& node, peer* ptr) = 0;
 
     /**
-     * @brief Returns the peer associated with given node id.
+     * @brief Returns the peer associated with given node id, i.e.,
+     *        the peer serving lane 0 of @p node.
      */
     virtual peer* get_peer(const node_id& node) = 0;
 
@@ -140,12 +204,51 @@ class middleman {
     virtual void del_peer(peer* ptr) = 0;
 
     /**
-     * @brief Delivers a message to given node.
+     * @brief Delivers a message to given node. The message is serialized
+     *        by the calling thread.
+     * @note This member function is thread-safe.
      */
     virtual void deliver(const node_id& node,
                          const message_header& hdr,
                          any_tuple msg                  ) = 0;
 
+    /**
+     * @brief Returns the outbound lanes of @p node, which are shared by
+     *        the peers serving @p node and all proxies of its actors.
+     * @note This member function is thread-safe.
+     */
+    virtual message_lanes_ptr outbound_lanes(const node_id& node) = 0;
+
+    /**
+     * @brief Returns the outbound queue of lane 0 of @p node.
+     * @note This member function is thread-safe.
+     */
+    inline default_message_queue_ptr outbound_queue(const node_id& node) {
+        return outbound_lanes(node)->queue(0);
+    }
+
+    /**
+     * @brief Causes the event loop serving @p lane of @p node to send all
+     *        messages from the outbound queue of that lane. Must be called
+     *        whenever {@link default_message_queue::enqueue()} returns
+     *        @p true.
+     * @note This member function is thread-safe.
+     */
+    virtual void flush_later(const node_id_ptr& node, size_t lane = 0) = 0;
+
+    /**
+     * @brief Sets the lanes this node offers to @p node as bitmask
+     *        and sends them to @p node via a @p LANES message.
+     * @warning Must be called from the event loop serving lane 0 of @p node.
+     */
+    virtual void offer_lanes(const node_id& node, std::uint32_t mask) = 0;
+
+    /**
+     * @brief Sets the lanes @p node offers to this node as bitmask.
+     * @warning Must be called from the event loop serving lane 0 of @p node.
+     */
+    virtual void accept_lanes(const node_id& node, std::uint32_t mask) = 0;
+
     /**
      * @brief This callback is invoked by {@link peer} implementations
      *        and causes the middleman to disconnect from the node.
@@ -153,11 +256,15 @@ class middleman {
     virtual void last_proxy_exited(peer* ptr) = 0;
 
     /**
-     *
+     * @brief Adds a new peer for given streams. If @p node is set, the
+     *        calling event loop serves the peer and this node initiated
+     *        the connection for @p lane, otherwise @p lane is ignored
+     *        and the handshake of the remote node is read first.
      */
     virtual void new_peer(const input_stream_ptr& in,
                           const output_stream_ptr& out,
-                          const node_id_ptr& node = nullptr) = 0;
+                          const node_id_ptr& node = nullptr,
+                          size_t lane = 0) = 0;
 
     /**
      * @brief Adds a new acceptor for incoming connections to @p pa
@@ -192,14 +299,23 @@ class middleman {
     // initializes a singleton
     virtual void initialize() = 0;
 
+    // enqueues ev to the first event loop
+    virtual void enqueue(middleman_event* ev) = 0;
+
+    // enqueues ev to the event loop serving node
+    virtual void enqueue(const node_id& node, middleman_event* ev) = 0;
+
+    template<typename F>
+    static inline middleman_event* new_event(F fun) {
+        return detail::memory::create<middleman_event_impl<F>>(std::move(fun));
+    }
+
     // each middleman defines its own namespace
     actor_namespace m_namespace;
 
     // the node id of this middleman
     node_id_ptr m_node;
 
-    std::unique_ptr<middleman_event_handler> m_handler;
-
 };
 
 inline actor_namespace& middleman::get_namespace() {
@@ -37,6 +37,14 @@
 
 namespace cppa { namespace io {
 
+/**
+ * @brief A contiguous chunk of memory used for gathered writes.
+ */
+struct output_slice {
+    const void* data;
+    size_t size;
+};
+
 /**
  * @brief An abstract output stream interface.
  */
@@ -65,6 +73,25 @@ class output_stream : public virtual ref_counted {
      */
     virtual size_t write_some(const void* buf, size_t num_bytes) = 0;
 
+    /**
+     * @brief Tries to write the concatenation of @p num_slices slices
+     *        starting at @p slices, ideally using a single system call.
+     * @returns The number of written bytes.
+     * @throws std::ios_base::failure
+     * @note The default implementation calls write_some() for each slice
+     *       and stops at the first partial write.
+     */
+    virtual size_t write_gathered(const output_slice* slices,
+                                  size_t num_slices) {
+        size_t result = 0;
+        for (size_t i = 0; i < num_slices; ++i) {
+            auto written = write_some(slices[i].data, slices[i].size);
+            result += written;
+            if (written != slices[i].size) return result;
+        }
+        return result;
+    }
+
 };
 
 /**
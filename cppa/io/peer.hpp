@@ -32,11 +32,13 @@
 #define CPPA_peer_IMPL_HPP
 
 #include <map>
+#include <vector>
 #include <cstdint>
 
 #include "cppa/extend.hpp"
 #include "cppa/node_id.hpp"
 #include "cppa/actor_proxy.hpp"
+#include "cppa/wire_format.hpp"
 #include "cppa/partial_function.hpp"
 #include "cppa/type_lookup_table.hpp"
 #include "cppa/weak_intrusive_ptr.hpp"
@@ -45,6 +47,7 @@
 
 #include "cppa/io/input_stream.hpp"
 #include "cppa/io/output_stream.hpp"
+#include "cppa/io/message_lanes.hpp"
 #include "cppa/io/buffered_writing.hpp"
 #include "cppa/io/default_message_queue.hpp"
 
@@ -63,7 +66,8 @@ class peer : public extend<continuable>::with<buffered_writing> {
     peer(middleman* parent,
          const input_stream_ptr& in,
          const output_stream_ptr& out,
-         node_id_ptr peer_ptr = nullptr);
+         node_id_ptr peer_ptr = nullptr,
+         size_t lane = 0);
 
     continue_reading_result continue_reading() override;
 
@@ -83,6 +87,13 @@ class peer : public extend<continuable>::with<buffered_writing> {
         return *m_node;
     }
 
+    /**
+     * @brief Returns the lane of {@link node()} served by this peer.
+     */
+    inline size_t lane() const {
+        return m_lane;
+    }
+
  private:
 
     enum read_state {
@@ -101,11 +112,25 @@ class peer : public extend<continuable>::with<buffered_writing> {
     const uniform_type_info* m_meta_hdr;
     const uniform_type_info* m_meta_msg;
 
+    // receive buffer; bytes before m_rd_pos are already processed
     util::buffer m_rd_buf;
-    util::buffer m_wr_buf;
+    size_t m_rd_pos;
+
+    // size and format of the message currently read (in state read_message)
+    std::uint32_t m_msg_size;
+    wire_format m_msg_format;
+    bool m_msg_compressed;
+
+    // holds the payload of compressed messages after decompression
+    std::vector<char> m_decompressed;
 
     default_message_queue_ptr m_queue;
 
+    // the lane served by this peer and all lanes of m_node,
+    // set once the remote node is known
+    size_t m_lane;
+    message_lanes_ptr m_lanes;
+
     inline default_message_queue& queue() {
         CPPA_REQUIRE(m_queue != nullptr);
         return *m_queue;
@@ -115,6 +140,25 @@ class peer : public extend<continuable>::with<buffered_writing> {
         m_queue = queue;
     }
 
+    // moves all serialized messages from the outbound queue
+    // to the output buffer
+    void flush_queue();
+
+    // moves all serialized messages from the outbound queue of a lane
+    // that has been merged into the lane of this peer to the output buffer
+    void flush_queue(default_message_queue& q);
+
+    // returns whether this peer is part of the connection to m_node,
+    // i.e., whether m_node is considered unreachable once it fails
+    bool connected_lane() const;
+
+    // tells the remote node the newest wire format and the optional
+    // features this node supports; older nodes drop this message silently
+    void announce_protocol();
+
+    // decompresses the payload of a compressed message to m_decompressed
+    bool decompress(const void* data, size_t size);
+
     // if this peer was created using remote_actor(), then m_doorman will
     // point to the published actor of the remote node
     bool m_stop_on_last_proxy_exited;
@@ -122,7 +166,6 @@ class peer : public extend<continuable>::with<buffered_writing> {
     partial_function m_content_handler;
 
     type_lookup_table m_incoming_types;
-    type_lookup_table m_outgoing_types;
 
     void monitor(const actor_addr& sender, const node_id_ptr& node, actor_id aid);
 
@@ -134,14 +177,13 @@ class peer : public extend<continuable>::with<buffered_writing> {
 
     void deliver(const message_header& hdr, any_tuple msg);
 
+    // handles all complete messages in m_rd_buf starting at m_rd_pos
+    continue_reading_result handle_received_data();
+
     inline void enqueue(const any_tuple& msg) {
         enqueue({invalid_actor_addr, nullptr}, msg);
     }
 
-    void enqueue_impl(const message_header& hdr, const any_tuple& msg);
-
-    void add_type_if_needed(const std::string& tname);
-
 };
 
 } } // namespace cppa::network
@@ -36,6 +36,8 @@
 #include "cppa/memory_cached.hpp"
 #include "cppa/intrusive/single_reader_queue.hpp"
 
+#include "cppa/io/message_lanes.hpp"
+
 namespace cppa { namespace detail {
 
 class memory;
@@ -103,6 +105,8 @@ class remote_actor_proxy : public actor_proxy {
 
     middleman* m_parent;
     intrusive::single_reader_queue<sync_request_info, detail::disposer> m_pending_requests;
+    // outbound lanes of the peers serving m_node
+    message_lanes_ptr m_lanes;
 
 };
 
@@ -515,6 +515,15 @@ class local_actor : public extend<abstract_actor>::with<memory_cached> {
                                     const actor& whom,
                                     any_tuple&& what);
 
+    // like delayed_send_tuple, but returns a token for cancel_delayed_send
+    std::uint64_t cancellable_delayed_send_tuple(const channel& whom,
+                                                 const util::duration& rtime,
+                                                 any_tuple data);
+
+    // withdraws a message sent via cancellable_delayed_send_tuple
+    // unless it has been delivered already
+    void cancel_delayed_send(std::uint64_t token);
+
     // returns the response ID
     template<typename... Rs, typename... Ts>
     message_id sync_send_tuple_impl(message_priority mp,
@@ -538,6 +547,9 @@ class local_actor : public extend<abstract_actor>::with<memory_cached> {
 
     inline void mark_arrived(message_id response_id);
 
+    // withdraws the timeout of a timed sync message
+    void cancel_sync_timeout(message_id response_id);
+
     inline std::uint32_t planned_exit_reason() const;
 
     inline void planned_exit_reason(std::uint32_t value);
@@ -581,6 +593,10 @@ class local_actor : public extend<abstract_actor>::with<memory_cached> {
     // identifies all IDs of sync messages waiting for a response
     std::vector<message_id> m_pending_responses;
 
+    // maps the response IDs of timed sync messages to the cancel
+    // token of their timeout
+    std::vector<std::pair<message_id, std::uint64_t>> m_sync_timeouts;
+
     // "default value" for m_current_node
     mailbox_element m_dummy_node;
 
@@ -666,6 +682,7 @@ inline void local_actor::mark_arrived(message_id response_id) {
     auto last = m_pending_responses.end();
     auto i = std::find(m_pending_responses.begin(), last, response_id);
     if (i != last) m_pending_responses.erase(i);
+    if (!m_sync_timeouts.empty()) cancel_sync_timeout(response_id);
 }
 
 inline std::uint32_t local_actor::planned_exit_reason() const {
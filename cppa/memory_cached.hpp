@@ -63,16 +63,10 @@ class memory_cached : public Base {
                                 , outer_memory(nullptr) { }
 
     virtual void request_deletion() {
-        auto mc = detail::memory::get_cache_map_entry(&typeid(*this));
-        if (!mc) {
-            auto om = outer_memory;
-            if (om) {
-                om->destroy();
-                om->deallocate();
-            }
-            else delete this;
-        }
-        else mc->release_instance(mc->downcast(this));
+        // instances created by detail::memory::create know their cache
+        auto om = outer_memory;
+        if (om) om->release();
+        else delete this;
     }
 
  private:
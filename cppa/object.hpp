@@ -103,7 +103,7 @@ class object {
      * @brief Creates an object and moves type and value
      *        from @p other to @c this.
      */
-    object(object&& other);
+    object(object&& other) noexcept;
 
     /**
      * @brief Creates a (deep) copy of @p other.
@@ -40,6 +40,7 @@
 #include "cppa/config.hpp"
 #include "cppa/extend.hpp"
 #include "cppa/behavior.hpp"
+#include "cppa/scheduler.hpp"
 #include "cppa/actor_state.hpp"
 
 #include "cppa/policy/resume_policy.hpp"
@@ -91,10 +92,18 @@ class event_based_resume {
                 return    d->bhvr_stack().empty()
                        || d->planned_exit_reason() != exit_reason::not_exited;
             };
+            // messages left before yielding the worker to other jobs
+            auto budget = max_throughput();
             try {
                 for (;;) {
+                    if (budget == 0 && d->has_next_message()) {
+                        CPPA_LOG_DEBUG("throughput budget exhausted; "
+                                       "going to be rescheduled");
+                        return resumable::reschedule;
+                    }
                     auto ptr = d->next_message();
                     if (ptr) {
+                        if (budget > 0) --budget;
                         CPPA_REQUIRE(!d->bhvr_stack().empty());
                         if (d->invoke_message(ptr)) {
                             if (actor_done() && done_cb()) {
@@ -35,6 +35,8 @@
 
 #include "cppa/mailbox_element.hpp"
 
+#include "cppa/intrusive/singly_linked_list.hpp"
+
 #include "cppa/policy/priority_policy.hpp"
 
 namespace cppa {
@@ -44,7 +46,8 @@ class not_prioritizing {
 
  public:
 
-    typedef std::vector<unique_mailbox_element_pointer> cache_type;
+    typedef intrusive::singly_linked_list<mailbox_element, detail::disposer>
+            cache_type;
 
     typedef cache_type::iterator cache_iterator;
 
@@ -55,11 +58,13 @@ class not_prioritizing {
 
     template<class Actor>
     inline bool has_next_message(Actor* self) {
-        return self->mailbox().can_fetch_more();
+        // try_pop fetches all new elements at once, i.e., the
+        // mailbox can have cached elements while its stack is empty
+        return !self->mailbox().empty();
     }
 
     inline void push_to_cache(unique_mailbox_element_pointer ptr) {
-        m_cache.push_back(std::move(ptr));
+        m_cache.push_back(ptr.release());
     }
 
     inline cache_iterator cache_begin() {
@@ -70,25 +75,21 @@ class not_prioritizing {
         return m_cache.end();
     }
 
-    inline void cache_erase(cache_iterator iter) {
-        m_cache.erase(iter);
+    inline unique_mailbox_element_pointer cache_take(cache_iterator iter) {
+        return unique_mailbox_element_pointer{m_cache.take(iter)};
     }
 
-    inline bool cache_empty() const {
-        return m_cache.empty();
+    inline void cache_insert(cache_iterator pos,
+                             unique_mailbox_element_pointer ptr) {
+        m_cache.insert(pos, ptr.release());
     }
 
-    inline unique_mailbox_element_pointer cache_take_first() {
-        auto tmp = std::move(m_cache.front());
-        m_cache.erase(m_cache.begin());
-        return std::move(tmp);
+    inline bool cache_empty() const {
+        return m_cache.empty();
     }
 
-    template<typename Iterator>
-    inline void cache_prepend(Iterator first, Iterator last) {
-        auto mi = std::make_move_iterator(first);
-        auto me = std::make_move_iterator(last);
-        m_cache.insert(m_cache.begin(), mi, me);
+    inline size_t cache_size() const {
+        return m_cache.size();
     }
 
  private:
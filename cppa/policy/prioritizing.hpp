@@ -32,9 +32,13 @@
 #define PRIORITIZING_HPP
 
 #include <iostream>
+#include <algorithm>
 
 #include "cppa/mailbox_element.hpp"
 #include "cppa/message_priority.hpp"
+
+#include "cppa/intrusive/singly_linked_list.hpp"
+
 #include "cppa/detail/sync_request_bouncer.hpp"
 
 namespace cppa { namespace policy {
@@ -43,7 +47,8 @@ class prioritizing {
 
  public:
 
-    typedef std::vector<unique_mailbox_element_pointer> cache_type;
+    typedef intrusive::singly_linked_list<mailbox_element, detail::disposer>
+            cache_type;
 
     typedef cache_type::iterator cache_iterator;
 
@@ -51,12 +56,10 @@ class prioritizing {
     unique_mailbox_element_pointer next_message(Actor* self) {
         if (!m_high.empty()) return take_first(m_high);
         // read whole mailbox
-        unique_mailbox_element_pointer tmp{self->mailbox().try_pop()};
-        while (tmp) {
-            if (tmp->mid.is_high_priority()) m_high.push_back(std::move(tmp));
-            else m_low.push_back(std::move(tmp));
-            tmp.reset(self->mailbox().try_pop());
-        }
+        self->mailbox().drain([&](mailbox_element* e) {
+            if (e->mid.is_high_priority()) m_high.push_back(e);
+            else m_low.push_back(e);
+        });
         if (!m_high.empty()) return take_first(m_high);
         if (!m_low.empty()) return take_first(m_low);
         return unique_mailbox_element_pointer{};
@@ -70,9 +73,9 @@ class prioritizing {
     inline void push_to_cache(unique_mailbox_element_pointer ptr) {
         if (ptr->mid.is_high_priority()) {
             // insert before first element with low priority
-            m_cache.insert(cache_low_begin(), std::move(ptr));
+            m_cache.insert(cache_low_begin(), ptr.release());
         }
-        else m_cache.push_back(std::move(ptr));
+        else m_cache.push_back(ptr.release());
     }
 
     inline cache_iterator cache_begin() {
@@ -80,39 +83,24 @@ class prioritizing {
     }
 
     inline cache_iterator cache_end() {
-        return m_cache.begin();
+        return m_cache.end();
     }
 
-    inline void cache_erase(cache_iterator iter) {
-        m_cache.erase(iter);
+    inline unique_mailbox_element_pointer cache_take(cache_iterator iter) {
+        return unique_mailbox_element_pointer{m_cache.take(iter)};
     }
 
-    inline bool cache_empty() const {
-        return m_cache.empty();
+    inline void cache_insert(cache_iterator pos,
+                             unique_mailbox_element_pointer ptr) {
+        m_cache.insert(pos, ptr.release());
     }
 
-    inline unique_mailbox_element_pointer cache_take_first() {
-        return take_first(m_cache);
+    inline bool cache_empty() const {
+        return m_cache.empty();
     }
 
-    template<typename Iterator>
-    inline void cache_prepend(Iterator first, Iterator last) {
-        using std::make_move_iterator;
-        // split input range between high and low priority messages
-        cache_type high;
-        cache_type low;
-        for (; first != last; ++first) {
-            if ((*first)->mid.is_high_priority()) high.push_back(std::move(*first));
-            else low.push_back(std::move(*first));
-        }
-        // prepend high priority messages
-        m_cache.insert(m_cache.begin(),
-                       make_move_iterator(high.begin()),
-                       make_move_iterator(high.end()));
-        // insert low priority messages after high priority messages
-        m_cache.insert(cache_low_begin(),
-                       make_move_iterator(low.begin()),
-                       make_move_iterator(low.end()));
+    inline size_t cache_size() const {
+        return m_cache.size();
     }
 
  private:
@@ -120,15 +108,13 @@ class prioritizing {
     cache_iterator cache_low_begin() {
         // insert before first element with low priority
         return std::find_if(m_cache.begin(), m_cache.end(),
-                            [](const unique_mailbox_element_pointer& e) {
+                            [](const mailbox_element* e) {
             return !e->mid.is_high_priority();
         });
     }
 
     inline unique_mailbox_element_pointer take_first(cache_type& from) {
-        auto tmp = std::move(from.front());
-        from.erase(from.begin());
-        return std::move(tmp);
+        return unique_mailbox_element_pointer{from.take_front()};
     }
 
     cache_type m_cache;
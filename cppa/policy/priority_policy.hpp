@@ -31,7 +31,10 @@
 #ifndef CPPA_PRIORITY_POLICY_HPP
 #define CPPA_PRIORITY_POLICY_HPP
 
+#include "cppa/intrusive/singly_linked_list.hpp"
+
 namespace cppa { class mailbox_element; }
+namespace cppa { namespace detail { struct disposer; } }
 
 namespace cppa { namespace policy {
 
@@ -57,7 +60,12 @@ class priority_policy {
 
     void push_to_cache(unique_mailbox_element_pointer ptr);
 
-    typedef std::vector<unique_mailbox_element_pointer> cache_type;
+    /**
+     * @brief An intrusive list of skipped messages, linked via
+     *        {@link mailbox_element::next}.
+     */
+    typedef intrusive::singly_linked_list<mailbox_element, detail::disposer>
+            cache_type;
 
     typedef cache_type::iterator cache_iterator;
 
@@ -65,7 +73,20 @@ class priority_policy {
 
     cache_iterator cache_end();
 
-    void cache_erase(cache_iterator iter);
+    /**
+     * @brief Removes the element at @p iter from the cache in O(1);
+     *        @p iter refers to its successor afterwards.
+     */
+    unique_mailbox_element_pointer cache_take(cache_iterator iter);
+
+    /**
+     * @brief Inserts @p ptr before @p pos in O(1).
+     */
+    void cache_insert(cache_iterator pos, unique_mailbox_element_pointer ptr);
+
+    bool cache_empty() const;
+
+    size_t cache_size() const;
 
 };
 
@@ -60,8 +60,10 @@ class resume_policy {
     /**
      * @brief Resumes the actor by reading a new message <tt>msg</tt> and then
      *        calling <tt>self->invoke(msg)</tt>. This process is repeated
-     *        until either no message is left in the actor's mailbox or the
-     *        actor finishes execution.
+     *        until either no message is left in the actor's mailbox, the
+     *        actor finishes execution, or the actor has used up its
+     *        throughput budget (see {@link max_throughput}) in which case
+     *        <tt>resumable::reschedule</tt> is returned.
      */
     template<class Actor>
     detail::resumable::resume_result resume(Actor* self,
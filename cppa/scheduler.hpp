@@ -85,6 +85,12 @@ class scheduler {
      */
     virtual void destroy();
 
+    /**
+     * @brief Returns the number of timer threads serving delayed messages.
+     *        Delayed messages are assigned to a timer by their sender.
+     */
+    virtual size_t num_timers() const;
+
  public:
 
     actor printer() const;
@@ -95,23 +101,42 @@ class scheduler {
     void delayed_send(message_header hdr,
                       const Duration& rel_time,
                       any_tuple data           ) {
+        auto helper = delayed_send_helper(hdr.sender);
         auto tup = make_any_tuple(atom("SEND"),
                                   util::duration{rel_time},
                                   std::move(hdr),
                                   std::move(data));
-        delayed_send_helper()->enqueue(message_header{}, std::move(tup));
+        helper->enqueue(message_header{}, std::move(tup));
     }
 
+    /**
+     * @brief Like {@link delayed_send}, but returns a token that allows
+     *        the sender to withdraw the message before its delivery.
+     * @returns A non-zero token for {@link cancel_delayed_send}.
+     */
+    std::uint64_t cancellable_delayed_send(message_header hdr,
+                                           const util::duration& rel_time,
+                                           any_tuple data);
+
+    /**
+     * @brief Withdraws the delayed message identified by @p token unless
+     *        it has been delivered already.
+     * @param sender The sender of the delayed message.
+     * @param token A token returned by {@link cancellable_delayed_send}.
+     */
+    void cancel_delayed_send(const actor_addr& sender, std::uint64_t token);
+
     template<typename Duration, typename... Data>
     void delayed_reply(message_header hdr,
                        const Duration& rel_time,
                        any_tuple data           ) {
         CPPA_REQUIRE(hdr.id.valid() && hdr.id.is_response());
+        auto helper = delayed_send_helper(hdr.sender);
         auto tup = make_any_tuple(atom("SEND"),
                                   util::duration{rel_time},
                                   std::move(hdr),
                                   std::move(data));
-        delayed_send_helper()->enqueue(message_header{}, std::move(tup));
+        helper->enqueue(message_header{}, std::move(tup));
     }
 
  private:
@@ -120,7 +145,7 @@ class scheduler {
 
     inline void dispose() { delete this; }
 
-    actor delayed_send_helper();
+    actor delayed_send_helper(const actor_addr& sender);
 
     scheduler_helper* m_helper;
 
@@ -140,6 +165,51 @@ void set_scheduler(scheduler* sched);
  */
 void set_default_scheduler(size_t num_threads);
 
+/**
+ * @brief Sets a work-stealing scheduler with @p num_threads worker threads.
+ *        If @p pin_workers is @p true, each worker is bound to one CPU and
+ *        workers are grouped per NUMA node (currently supported on Linux).
+ * @throws std::runtime_error if there's already a scheduler defined.
+ */
+void set_work_stealing_scheduler(size_t num_threads, bool pin_workers = false);
+
+/**
+ * @brief Limits the number of messages an event-based actor processes
+ *        per resume before it yields its worker and gets re-enqueued
+ *        at the tail of the job queue.
+ * @param max_messages Throughput budget per resume; @p 0 is treated as 1.
+ */
+void set_max_throughput(size_t max_messages);
+
+/**
+ * @brief Returns the number of messages an event-based actor processes
+ *        per resume, i.e., @p std::numeric_limits<size_t>::max()
+ *        (unlimited) unless set otherwise via {@link set_max_throughput}.
+ */
+size_t max_throughput();
+
+/**
+ * @brief Granularity of the timing wheels serving delayed messages,
+ *        receive timeouts, and timeouts of synchronous requests.
+ *
+ * - @p fine uses ticks of 1ms.
+ * - @p coarse uses ticks of 10ms, which results in fewer wakeups
+ *   of the timer threads at the cost of precision.
+ *
+ * Timeouts never fire early, but up to one tick late.
+ */
+enum class timer_resolution {
+    fine,
+    coarse
+};
+
+/**
+ * @brief Sets the resolution of all timers. Takes effect when
+ *        the scheduler starts, i.e., must be called before spawning
+ *        the first actor. The default is {@link timer_resolution::fine}.
+ */
+void set_timer_resolution(timer_resolution res);
+
 } // namespace cppa
 
 #endif // CPPA_SCHEDULER_HPP
@@ -53,9 +53,14 @@ class single_timeout : public Base {
     template <typename... Ts>
     single_timeout(Ts&&... args)
             : super(std::forward<Ts>(args)...), m_has_timeout(false)
-            , m_timeout_id(0) { }
+            , m_timeout_id(0), m_timeout_token(0) { }
 
     void request_timeout(const util::duration& d) {
+        // withdraw a superseded timeout before it fires
+        if (m_has_timeout && m_timeout_token != 0) {
+            this->cancel_delayed_send(m_timeout_token);
+        }
+        m_timeout_token = 0;
         if (d.valid()) {
             m_has_timeout = true;
             auto tid = ++m_timeout_id;
@@ -66,7 +71,10 @@ class single_timeout : public Base {
                 //auto e = this->new_mailbox_element(this, std::move(msg));
                 //this->m_mailbox.enqueue(e);
             }
-            else this->delayed_send_tuple(this, d, std::move(msg));
+            else {
+                m_timeout_token = this->cancellable_delayed_send_tuple(
+                                      this, d, std::move(msg));
+            }
         }
         else m_has_timeout = false;
     }
@@ -85,12 +93,14 @@ class single_timeout : public Base {
 
     inline void reset_timeout() {
         m_has_timeout = false;
+        m_timeout_token = 0;
     }
 
  protected:
 
     bool m_has_timeout;
     std::uint32_t m_timeout_id;
+    std::uint64_t m_timeout_token;
 
 };
 
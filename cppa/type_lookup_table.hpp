@@ -72,6 +72,18 @@ class type_lookup_table {
 
     std::uint32_t max_id() const;
 
+    /**
+     * @brief Returns the ID for the next type added to this table,
+     *        i.e., the smallest ID greater than all IDs in use or reserved.
+     */
+    std::uint32_t next_id() const;
+
+    /**
+     * @brief Reserves all IDs up to and including @p id, i.e.,
+     *        {@link next_id()} never returns a value less than @p id + 1.
+     */
+    void reserve_ids(std::uint32_t id);
+
  private:
 
     typedef std::vector<std::pair<std::uint32_t, pointer>> container;
@@ -81,6 +93,8 @@ class type_lookup_table {
 
     container m_data;
 
+    std::uint32_t m_reserved;
+
     const_iterator find(std::uint32_t) const;
 
     iterator find(std::uint32_t);
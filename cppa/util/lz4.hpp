@@ -0,0 +1,66 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#ifndef CPPA_LZ4_HPP
+#define CPPA_LZ4_HPP
+
+#include <cstddef>
+
+namespace cppa { namespace util {
+
+/**
+ * @brief Returns the maximum size of the compressed form
+ *        of @p num_bytes bytes, i.e., of incompressible data.
+ */
+size_t lz4_compress_bound(size_t num_bytes);
+
+/**
+ * @brief Compresses @p num_bytes bytes from @p data using the LZ4 block
+ *        format, i.e., without any framing, and writes the result
+ *        to @p storage.
+ * @param storage A memory region of at least
+ *                <tt>lz4_compress_bound(num_bytes)</tt> bytes.
+ * @returns The number of bytes written to @p storage.
+ */
+size_t lz4_compress(const void* data, size_t num_bytes, void* storage);
+
+/**
+ * @brief Decompresses @p num_bytes bytes of an LZ4 block
+ *        from @p data to @p storage.
+ * @returns @p true if @p data was a well-formed block decompressing
+ *          to exactly @p storage_size bytes, otherwise @p false.
+ * @note Never reads or writes out of bounds, even for malicious input.
+ */
+bool lz4_decompress(const void* data, size_t num_bytes,
+                    void* storage, size_t storage_size);
+
+} } // namespace cppa::util
+
+#endif // CPPA_LZ4_HPP
@@ -31,13 +31,13 @@
 #ifndef CPPA_PRODUCER_CONSUMER_LIST_HPP
 #define CPPA_PRODUCER_CONSUMER_LIST_HPP
 
-#define CPPA_CACHE_LINE_SIZE 64
-
 #include <chrono>
 #include <thread>
 #include <atomic>
 #include <cassert>
 
+#include "cppa/config.hpp"
+
 // GCC hack
 #if !defined(_GLIBCXX_USE_SCHED_YIELD) && !defined(__clang__)
 #include <time.h>
@@ -0,0 +1,57 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#ifndef CPPA_WIRE_FORMAT_HPP
+#define CPPA_WIRE_FORMAT_HPP
+
+#include <cstdint>
+
+namespace cppa {
+
+/**
+ * @brief Versions of the binary format used by {@link binary_serializer}
+ *        and {@link binary_deserializer}.
+ *
+ * - @p v1 writes integers at full width, lengths as 32 bit integers, and
+ *   type names whenever a type is not found in the lookup table.
+ * - @p v2 writes lengths, IDs, and integers wider than 8 bit as LEB128
+ *   varints (signed integers are zig-zag encoded first). A serializer
+ *   allowed to intern types assigns an ID to each new type and sends
+ *   its name only once along with the new ID.
+ */
+enum class wire_format : std::uint32_t {
+    v1 = 1,
+    v2 = 2
+};
+
+} // namespace cppa
+
+#endif // CPPA_WIRE_FORMAT_HPP
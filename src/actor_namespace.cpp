@@ -89,11 +89,13 @@ actor_addr actor_namespace::read(deserializer* source) {
 }
 
 size_t actor_namespace::count_proxies(const node_id& node) {
+    std::lock_guard<std::mutex> guard(m_mtx);
     auto i = m_proxies.find(node);
     return (i != m_proxies.end()) ? i->second.size() : 0;
 }
 
 actor_proxy_ptr actor_namespace::get(const node_id& node, actor_id aid) {
+    std::lock_guard<std::mutex> guard(m_mtx);
     auto& submap = m_proxies[node];
     auto i = submap.find(aid);
     if (i != submap.end()) {
@@ -108,41 +110,57 @@ actor_proxy_ptr actor_namespace::get(const node_id& node, actor_id aid) {
 }
 
 actor_proxy_ptr actor_namespace::get_or_put(node_id_ptr node, actor_id aid) {
-    auto result = get(*node, aid);
-    if (result == nullptr && m_factory) {
-        auto ptr = m_factory(aid, node);
-        put(*node, aid, ptr);
-        result = ptr;
+    actor_proxy_ptr result;
+    { // lifetime scope of guard
+        std::lock_guard<std::mutex> guard(m_mtx);
+        auto& submap = m_proxies[*node];
+        auto i = submap.find(aid);
+        if (i != submap.end()) {
+            result = i->second.promote();
+            if (result) return result;
+            submap.erase(i);
+        }
+        if (!m_factory) return nullptr;
+        result = m_factory(aid, node);
+        submap.insert(std::make_pair(aid, result));
     }
+    // invoke callback without holding the lock
+    if (m_new_element_callback) m_new_element_callback(aid, *node);
     return result;
 }
 
 void actor_namespace::put(const node_id& node,
                           actor_id aid,
                           const actor_proxy_ptr& proxy) {
-    auto& submap = m_proxies[node];
-    auto i = submap.find(aid);
-    if (i == submap.end()) {
+    { // lifetime scope of guard
+        std::lock_guard<std::mutex> guard(m_mtx);
+        auto& submap = m_proxies[node];
+        auto i = submap.find(aid);
+        if (i != submap.end()) {
+            CPPA_LOG_ERROR("proxy for " << aid << ":"
+                           << to_string(node) << " already exists");
+            return;
+        }
         submap.insert(std::make_pair(aid, proxy));
-        if (m_new_element_callback) m_new_element_callback(aid, node);
-    }
-    else {
-        CPPA_LOG_ERROR("proxy for " << aid << ":"
-                       << to_string(node) << " already exists");
     }
+    // invoke callback without holding the lock
+    if (m_new_element_callback) m_new_element_callback(aid, node);
 }
 
-auto actor_namespace::proxies(node_id& node) -> proxy_map& {
+auto actor_namespace::proxies(node_id& node) -> proxy_map {
+    std::lock_guard<std::mutex> guard(m_mtx);
     return m_proxies[node];
 }
 
 void actor_namespace::erase(node_id& inf) {
     CPPA_LOG_TRACE(CPPA_TARG(inf, to_string));
+    std::lock_guard<std::mutex> guard(m_mtx);
     m_proxies.erase(inf);
 }
 
 void actor_namespace::erase(node_id& inf, actor_id aid) {
     CPPA_LOG_TRACE(CPPA_TARG(inf, to_string) << ", " << CPPA_ARG(aid));
+    std::lock_guard<std::mutex> guard(m_mtx);
     auto i = m_proxies.find(inf);
     if (i != m_proxies.end()) {
         i->second.erase(aid);
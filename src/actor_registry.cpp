@@ -49,12 +49,24 @@ typedef cppa::util::upgrade_lock_guard<cppa::util::shared_spinlock> upgrade_guar
 
 namespace cppa { namespace detail {
 
-actor_registry::actor_registry() : m_running(0), m_ids(1) { }
+namespace {
+
+// assigns counters to threads in round-robin order
+std::atomic<size_t> s_next_counter{0};
+
+__thread size_t t_counter = 0;
+
+} // namespace <anonymous>
+
+actor_registry::actor_registry() : m_ids(1), m_awaiting(0) {
+    for (auto& c : m_running) c.value = 0;
+}
 
 actor_registry::value_type actor_registry::get_entry(actor_id key) const {
-    shared_guard guard(m_instances_mtx);
-    auto i = m_entries.find(key);
-    if (i != m_entries.end()) {
+    auto& s = shard_for(key);
+    shared_guard guard(s.mtx);
+    auto i = s.data.find(key);
+    if (i != s.data.end()) {
         return i->second;
     }
     CPPA_LOG_DEBUG("key not found: " << key);
@@ -64,14 +76,15 @@ actor_registry::value_type actor_registry::get_entry(actor_id key) const {
 void actor_registry::put(actor_id key, const abstract_actor_ptr& value) {
     bool add_attachable = false;
     if (value != nullptr) {
-        shared_guard guard(m_instances_mtx);
-        auto i = m_entries.find(key);
-        if (i == m_entries.end()) {
+        auto& s = shard_for(key);
+        shared_guard guard(s.mtx);
+        auto i = s.data.find(key);
+        if (i == s.data.end()) {
             auto entry = std::make_pair(key,
                                         value_type(value,
                                                    exit_reason::not_exited));
             upgrade_guard uguard(guard);
-            add_attachable = m_entries.insert(entry).second;
+            add_attachable = s.data.insert(entry).second;
         }
     }
     if (add_attachable) {
@@ -92,9 +105,10 @@ void actor_registry::put(actor_id key, const abstract_actor_ptr& value) {
 }
 
 void actor_registry::erase(actor_id key, std::uint32_t reason) {
-    exclusive_guard guard(m_instances_mtx);
-    auto i = m_entries.find(key);
-    if (i != m_entries.end()) {
+    auto& s = shard_for(key);
+    exclusive_guard guard(s.mtx);
+    auto i = s.data.find(key);
+    if (i != s.data.end()) {
         auto& entry = i->second;
         CPPA_LOG_INFO("erased actor with ID " << key << ", reason " << reason);
         entry.first = nullptr;
@@ -106,38 +120,45 @@ std::uint32_t actor_registry::next_id() {
     return m_ids.fetch_add(1);
 }
 
+actor_registry::counter& actor_registry::local_counter() {
+    // 0 means 'not assigned yet'
+    if (t_counter == 0) t_counter = (s_next_counter++ % num_counters) + 1;
+    return m_running[t_counter - 1];
+}
+
 void actor_registry::inc_running() {
-#   if CPPA_LOG_LEVEL >= CPPA_DEBUG
-    CPPA_LOG_DEBUG("new value = " << ++m_running);
-#   else
-    ++m_running;
-#   endif
+    ++local_counter().value;
+    CPPA_LOG_DEBUG("new value = " << running());
 }
 
 size_t actor_registry::running() const {
-    return m_running.load();
+    long result = 0;
+    for (auto& c : m_running) result += c.value.load();
+    return static_cast<size_t>(result);
 }
 
 void actor_registry::dec_running() {
-    size_t new_val = --m_running;
-    /*
-    if (new_val == std::numeric_limits<size_t>::max()) {
-        throw std::underflow_error("actor_count::dec()");
-    }
-    else*/ if (new_val <= 1) {
-        std::unique_lock<std::mutex> guard(m_running_mtx);
-        m_running_cv.notify_all();
+    --local_counter().value;
+    // summing up all counters is only needed if someone is waiting
+    if (m_awaiting > 0) {
+        auto new_val = running();
+        if (new_val <= 1) {
+            std::unique_lock<std::mutex> guard(m_running_mtx);
+            m_running_cv.notify_all();
+        }
+        CPPA_LOG_DEBUG(CPPA_ARG(new_val));
     }
-    CPPA_LOG_DEBUG(CPPA_ARG(new_val));
 }
 
 void actor_registry::await_running_count_equal(size_t expected) {
     CPPA_LOG_TRACE(CPPA_ARG(expected));
     std::unique_lock<std::mutex> guard{m_running_mtx};
-    while (m_running != expected) {
-        CPPA_LOG_DEBUG("count = " << m_running.load());
+    ++m_awaiting;
+    while (running() != expected) {
+        CPPA_LOG_DEBUG("count = " << running());
         m_running_cv.wait(guard);
     }
+    --m_awaiting;
 }
 
 } } // namespace cppa::detail
@@ -29,6 +29,7 @@
 
 
 #include <string>
+#include <limits>
 #include <cstdint>
 #include <cstring>
 #include <sstream>
@@ -68,88 +69,142 @@ inline void range_check(pointer begin, pointer end, size_t read_size) {
     }
 }
 
-pointer read_range(pointer begin, pointer end, string& storage);
+pointer read_varint(pointer begin, pointer end, std::uint64_t& storage) {
+    storage = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        range_check(begin, end, 1);
+        auto byte = *reinterpret_cast<const std::uint8_t*>(begin);
+        begin = advanced(begin, 1);
+        storage |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) return begin;
+    }
+    CPPA_LOGF(CPPA_ERROR, "varint too long");
+    throw out_of_range("binary_deserializer::read_varint()");
+}
+
+pointer read_length(pointer begin, pointer end, wire_format format,
+                    std::uint32_t& storage) {
+    if (format == wire_format::v1) {
+        range_check(begin, end, sizeof(std::uint32_t));
+        memcpy(&storage, begin, sizeof(std::uint32_t));
+        return advanced(begin, sizeof(std::uint32_t));
+    }
+    std::uint64_t tmp;
+    begin = read_varint(begin, end, tmp);
+    if (tmp > std::numeric_limits<std::uint32_t>::max()) {
+        throw out_of_range("binary_deserializer::read_length()");
+    }
+    storage = static_cast<std::uint32_t>(tmp);
+    return begin;
+}
+
+template<typename T>
+typename enable_if<is_signed<T>::value, T>::type from_zig_zag(std::uint64_t x) {
+    return static_cast<T>(static_cast<std::int64_t>(x >> 1)
+                          ^ -static_cast<std::int64_t>(x & 1));
+}
 
 template<typename T>
-pointer read_range(pointer begin, pointer end, T& storage,
+typename enable_if<!is_signed<T>::value, T>::type from_zig_zag(std::uint64_t x) {
+    return static_cast<T>(x);
+}
+
+pointer read_range(pointer begin, pointer end, wire_format format,
+                   string& storage);
+
+template<typename T>
+pointer read_range(pointer begin, pointer end, wire_format format, T& storage,
                    typename enable_if<is_integral<T>::value>::type* = 0) {
-    range_check(begin, end, sizeof(T));
-    memcpy(&storage, begin, sizeof(T));
-    return advanced(begin, sizeof(T));
+    if (format == wire_format::v1 || sizeof(T) == 1) {
+        range_check(begin, end, sizeof(T));
+        memcpy(&storage, begin, sizeof(T));
+        return advanced(begin, sizeof(T));
+    }
+    std::uint64_t tmp;
+    begin = read_varint(begin, end, tmp);
+    storage = from_zig_zag<T>(tmp);
+    return begin;
 }
 
 template<typename T>
-pointer read_range(pointer begin, pointer end, T& storage,
+pointer read_range(pointer begin, pointer end, wire_format, T& storage,
                    typename enable_if<is_floating_point<T>::value>::type* = 0) {
     typename detail::ieee_754_trait<T>::packed_type tmp;
-    auto result = read_range(begin, end, tmp);
+    // packed floating point values always have full width
+    auto result = read_range(begin, end, wire_format::v1, tmp);
     storage = detail::unpack754(tmp);
     return result;
 }
 
 // the IEEE-754 conversion does not work for long double
 // => fall back to string serialization (event though it sucks)
-pointer read_range(pointer begin, pointer end, long double& storage) {
+pointer read_range(pointer begin, pointer end, wire_format format,
+                   long double& storage) {
     std::string tmp;
-    auto result = read_range(begin, end, tmp);
+    auto result = read_range(begin, end, format, tmp);
     std::istringstream iss{std::move(tmp)};
     iss >> storage;
     return result;
 }
 
-pointer read_range(pointer begin, pointer end, string& storage) {
+pointer read_range(pointer begin, pointer end, wire_format format,
+                   string& storage) {
     uint32_t str_size;
-    begin = read_range(begin, end, str_size);
+    begin = read_length(begin, end, format, str_size);
     range_check(begin, end, str_size);
-    storage.clear();
-    storage.reserve(str_size);
-    pointer cpy_end = advanced(begin, str_size);
-    copy(as_char_pointer(begin), as_char_pointer(cpy_end), back_inserter(storage));
+    storage.assign(as_char_pointer(begin), str_size);
     return advanced(begin, str_size);
 }
 
 template<typename CharType, typename StringType>
-pointer read_unicode_string(pointer begin, pointer end, StringType& str) {
+pointer read_unicode_string(pointer begin, pointer end, wire_format format,
+                            StringType& str) {
     uint32_t str_size;
-    begin = read_range(begin, end, str_size);
+    begin = read_length(begin, end, format, str_size);
     str.reserve(str_size);
     for (size_t i = 0; i < str_size; ++i) {
         CharType c;
-        begin = read_range(begin, end, c);
+        // characters always have full width
+        begin = read_range(begin, end, wire_format::v1, c);
         str += static_cast<typename StringType::value_type>(c);
     }
     return begin;
 }
 
-pointer read_range(pointer begin, pointer end, atom_value& storage) {
+pointer read_range(pointer begin, pointer end, wire_format format,
+                   atom_value& storage) {
     std::uint64_t tmp;
-    auto result = read_range(begin, end, tmp);
+    auto result = read_range(begin, end, format, tmp);
     storage = static_cast<atom_value>(tmp);
     return result;
 }
 
-pointer read_range(pointer begin, pointer end, u16string& storage) {
+pointer read_range(pointer begin, pointer end, wire_format format,
+                   u16string& storage) {
     // char16_t is guaranteed to has *at least* 16 bytes,
     // but not to have *exactly* 16 bytes; thus use uint16_t
-    return read_unicode_string<uint16_t>(begin, end, storage);
+    return read_unicode_string<uint16_t>(begin, end, format, storage);
 }
 
-pointer read_range(pointer begin, pointer end, u32string& storage) {
+pointer read_range(pointer begin, pointer end, wire_format format,
+                   u32string& storage) {
     // char32_t is guaranteed to has *at least* 32 bytes,
     // but not to have *exactly* 32 bytes; thus use uint32_t
-    return read_unicode_string<uint32_t>(begin, end, storage);
+    return read_unicode_string<uint32_t>(begin, end, format, storage);
 }
 
 struct pt_reader {
 
     pointer begin;
     pointer end;
+    wire_format format;
 
-    pt_reader(pointer bbegin, pointer bend) : begin(bbegin), end(bend) { }
+    pt_reader(pointer bbegin, pointer bend, wire_format fmt)
+    : begin(bbegin), end(bend), format(fmt) { }
 
     template<typename T>
     inline void operator()(T& value) {
-        begin = read_range(begin, end, value);
+        begin = read_range(begin, end, format, value);
     }
 
 };
@@ -158,20 +213,36 @@ struct pt_reader {
 
 binary_deserializer::binary_deserializer(const void* buf, size_t buf_size,
                                          actor_namespace* ns,
-                                         type_lookup_table* tbl)
-: super(ns, tbl), m_pos(buf), m_end(advanced(buf, buf_size)) { }
+                                         type_lookup_table* tbl,
+                                         wire_format format)
+: super(ns, tbl), m_pos(buf), m_end(advanced(buf, buf_size))
+, m_format(format) { }
 
 binary_deserializer::binary_deserializer(const void* bbegin, const void* bend,
                                          actor_namespace* ns,
-                                         type_lookup_table* tbl)
-: super(ns, tbl), m_pos(bbegin), m_end(bend) { }
+                                         type_lookup_table* tbl,
+                                         wire_format format)
+: super(ns, tbl), m_pos(bbegin), m_end(bend), m_format(format) { }
 
 const uniform_type_info* binary_deserializer::begin_object() {
-    std::uint8_t flag;
-    m_pos = read_range(m_pos, m_end, flag);
-    if (flag == 1) {
+    std::uint32_t type_id;
+    bool has_name;
+    if (m_format == wire_format::v1) {
+        std::uint8_t flag;
+        m_pos = read_range(m_pos, m_end, m_format, flag);
+        has_name = flag == 1;
+        if (!has_name) m_pos = read_range(m_pos, m_end, m_format, type_id);
+        else type_id = 0;
+    }
+    else {
+        std::uint64_t tmp;
+        m_pos = read_varint(m_pos, m_end, tmp);
+        has_name = (tmp & 1) == 1;
+        type_id = static_cast<std::uint32_t>(tmp >> 1);
+    }
+    if (has_name) {
         string tname;
-        m_pos = read_range(m_pos, m_end, tname);
+        m_pos = read_range(m_pos, m_end, m_format, tname);
         auto uti = get_uniform_type_info_map()->by_uniform_name(tname);
         if (!uti) {
             std::string err = "received type name \"";
@@ -179,11 +250,12 @@ const uniform_type_info* binary_deserializer::begin_object() {
             err += "\" but no such type is known";
             throw std::runtime_error(err);
         }
+        // v2 senders announce the ID of a type along with its name
+        auto it = incoming_types();
+        if (type_id != 0 && it) it->emplace(type_id, uti);
         return uti;
     }
     else {
-        std::uint32_t type_id;
-        m_pos = read_range(m_pos, m_end, type_id);
         auto it = incoming_types();
         if (!it) {
             std::string err = "received type ID ";
@@ -204,7 +276,7 @@ size_t binary_deserializer::begin_sequence() {
     static_assert(sizeof(size_t) >= sizeof(uint32_t),
                   "sizeof(size_t) < sizeof(uint32_t)");
     uint32_t result;
-    m_pos = read_range(m_pos, m_end, result);
+    m_pos = read_length(m_pos, m_end, m_format, result);
     return static_cast<size_t>(result);
 }
 
@@ -212,7 +284,7 @@ void binary_deserializer::end_sequence() { }
 
 primitive_variant binary_deserializer::read_value(primitive_type ptype) {
     primitive_variant val(ptype);
-    pt_reader ptr(m_pos, m_end);
+    pt_reader ptr(m_pos, m_end, m_format);
     val.apply(ptr);
     m_pos = ptr.begin;
     return val;
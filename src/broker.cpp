@@ -358,15 +358,16 @@ bool broker::invoke_message_from_cache() {
     CPPA_LOG_TRACE("");
     auto bhvr = bhvr_stack().back();
     auto mid = bhvr_stack().back_id();
+    CPPA_LOG_DEBUG(m_priority_policy.cache_size() << " elements in cache");
     auto e = m_priority_policy.cache_end();
-    CPPA_LOG_DEBUG(std::distance(m_priority_policy.cache_begin(), e)
-                   << " elements in cache");
-    for (auto i = m_priority_policy.cache_begin(); i != e; ++i) {
-        auto res = m_invoke_policy.invoke_message(this, *i, bhvr, mid);
-        if (res || !*i) {
-            m_priority_policy.cache_erase(i);
-            if (res) return true;
-            return invoke_message_from_cache();
+    auto i = m_priority_policy.cache_begin();
+    while (i != e) {
+        // i refers to the successor of ptr after taking it
+        auto ptr = m_priority_policy.cache_take(i);
+        if (m_invoke_policy.invoke_message(this, ptr, bhvr, mid)) return true;
+        if (ptr) {
+            m_priority_policy.cache_insert(i, move(ptr));
+            ++i;
         }
     }
     return false;
@@ -0,0 +1,145 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <cctype>
+#include <thread>
+#include <sstream>
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "cppa/config.hpp"
+#include "cppa/detail/cpu_topology.hpp"
+
+#ifdef CPPA_LINUX
+#include <sched.h>
+#include <dirent.h>
+#endif
+
+namespace cppa { namespace detail {
+
+cpu_topology cpu_topology::detect() {
+    cpu_topology result;
+#   ifdef CPPA_LINUX
+    const std::string root = "/sys/devices/system/node";
+    std::vector<int> node_ids;
+    auto dir = opendir(root.c_str());
+    if (dir) {
+        for (auto entry = readdir(dir); entry; entry = readdir(dir)) {
+            std::string name = entry->d_name;
+            if (name.size() > 4 && name.compare(0, 4, "node") == 0
+                    && std::all_of(name.begin() + 4, name.end(), ::isdigit)) {
+                node_ids.push_back(std::stoi(name.substr(4)));
+            }
+        }
+        closedir(dir);
+    }
+    std::sort(node_ids.begin(), node_ids.end());
+    for (auto id : node_ids) {
+        std::ifstream in(root + "/node" + std::to_string(id) + "/cpulist");
+        std::string line;
+        if (std::getline(in, line)) {
+            auto cpus = parse_cpu_list(line);
+            // nodes without CPUs only provide memory
+            if (!cpus.empty()) result.m_nodes.push_back(std::move(cpus));
+        }
+    }
+#   endif
+    if (result.m_nodes.empty()) {
+        std::vector<int> cpus;
+        auto num_cpus = std::max(std::thread::hardware_concurrency(), 1u);
+        for (unsigned i = 0; i < num_cpus; ++i) {
+            cpus.push_back(static_cast<int>(i));
+        }
+        result.m_nodes.push_back(std::move(cpus));
+    }
+    for (size_t node = 0; node < result.m_nodes.size(); ++node) {
+        for (auto cpu : result.m_nodes[node]) {
+            auto pos = static_cast<size_t>(cpu);
+            if (result.m_cpu_to_node.size() <= pos) {
+                result.m_cpu_to_node.resize(pos + 1, 0);
+            }
+            result.m_cpu_to_node[pos] = node;
+        }
+    }
+    return result;
+}
+
+std::vector<int> cpu_topology::parse_cpu_list(const std::string& str) {
+    std::vector<int> result;
+    std::istringstream iss(str);
+    std::string range;
+    while (std::getline(iss, range, ',')) {
+        auto dash = range.find('-');
+        try {
+            if (dash == std::string::npos) {
+                result.push_back(std::stoi(range));
+            }
+            else {
+                auto first = std::stoi(range.substr(0, dash));
+                auto last = std::stoi(range.substr(dash + 1));
+                for (auto cpu = first; cpu <= last; ++cpu) {
+                    result.push_back(cpu);
+                }
+            }
+        }
+        catch (std::exception&) {
+            // ignore malformed entries (e.g. trailing whitespace)
+        }
+    }
+    return result;
+}
+
+bool cpu_topology::pin_current_thread(int cpu) {
+#   ifdef CPPA_LINUX
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    return sched_setaffinity(0, sizeof(cpu_set_t), &cpus) == 0;
+#   else
+    static_cast<void>(cpu);
+    return false;
+#   endif
+}
+
+size_t cpu_topology::node_of(int cpu) const {
+    auto pos = static_cast<size_t>(cpu);
+    return (cpu >= 0 && pos < m_cpu_to_node.size()) ? m_cpu_to_node[pos] : 0;
+}
+
+size_t cpu_topology::current_node() const {
+#   ifdef CPPA_LINUX
+    if (m_nodes.size() > 1) return node_of(sched_getcpu());
+#   endif
+    return 0;
+}
+
+} } // namespace cppa::detail
@@ -0,0 +1,263 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <iostream>
+
+#include "cppa/atom.hpp"
+#include "cppa/cppa.hpp"
+#include "cppa/logging.hpp"
+#include "cppa/to_string.hpp"
+#include "cppa/singletons.hpp"
+#include "cppa/binary_serializer.hpp"
+
+#include "cppa/util/lz4.hpp"
+
+#include "cppa/detail/raw_access.hpp"
+#include "cppa/detail/uniform_type_info_map.hpp"
+
+#include "cppa/io/default_message_queue.hpp"
+
+using namespace std;
+
+namespace cppa { namespace io {
+
+namespace {
+
+const string& tuple_type_name(const any_tuple& msg, string& storage) {
+    auto tname = msg.tuple_type_names();
+    if (tname) return *tname;
+    storage = detail::get_tuple_type_names(*msg.vals());
+    return storage;
+}
+
+} // namespace <anonymous>
+
+constexpr std::uint32_t default_message_queue::v2_flag;
+
+constexpr std::uint32_t default_message_queue::compressed_flag;
+
+default_message_queue::default_message_queue(actor_namespace* ns,
+                                             std::uint32_t first_type_id)
+: m_namespace(ns), m_format(wire_format::v1), m_compress(false)
+, m_low_watermark(0), m_high_watermark(0)
+, m_policy(overflow_policy::drop_low_priority), m_overloaded(false)
+, m_queued_messages(0), m_queued_bytes(0), m_unwritten_bytes(0)
+, m_rejected_messages(0), m_types(new type_lookup_table) {
+    if (first_type_id > 0) m_types->reserve_ids(first_type_id - 1);
+}
+
+bool default_message_queue::enqueue(const message_header& hdr,
+                                    const any_tuple& msg) {
+    CPPA_LOG_TRACE("");
+    auto e = detail::memory::create<element>();
+    auto format = m_format.load();
+    string storage;
+    auto& tname = tuple_type_name(msg, storage);
+    auto types = outgoing_types();
+    if (types->id_of(tname) != 0) {
+        // common case: serialize without holding any lock
+        serialize(e->buf, types.get(), format, hdr, msg);
+        return push(e);
+    }
+    lock_guard<mutex> guard{m_types_mtx};
+    if (format == wire_format::v1) {
+        add_type_if_needed(e->buf, tname);
+        serialize(e->buf, m_types.get(), format, hdr, msg);
+    }
+    else {
+        // the serializer adds all new types to a copy of the table,
+        // which becomes visible to other threads only on success
+        type_table_ptr cpy{new type_lookup_table(*m_types)};
+        if (serialize(e->buf, cpy.get(), format, hdr, msg, true)) {
+            m_types = cpy;
+        }
+    }
+    return push(e);
+}
+
+bool default_message_queue::push(element* e) {
+    // count before enqueueing, because the event loop
+    // may drain the element right away
+    m_queued_bytes += e->buf.size();
+    ++m_queued_messages;
+    check_high_watermark();
+    return m_impl.enqueue(e) == intrusive::first_enqueued;
+}
+
+bool default_message_queue::admit(const message_header& hdr) {
+    if (!m_overloaded) return true;
+    bool reject;
+    if (m_policy == overflow_policy::drop_low_priority) {
+        reject =    !hdr.id.is_high_priority()
+                 && !hdr.id.is_request() && !hdr.id.is_response();
+    }
+    else reject = hdr.id.is_request();
+    if (reject) ++m_rejected_messages;
+    return !reject;
+}
+
+void default_message_queue::watermarks(size_t low, size_t high,
+                                       overflow_policy policy) {
+    m_low_watermark = low;
+    m_high_watermark = high;
+    m_policy = policy;
+    check_high_watermark();
+}
+
+void default_message_queue::check_high_watermark() {
+    auto high = m_high_watermark.load();
+    if (high > 0 && !m_overloaded && pending_bytes() >= high) {
+        CPPA_LOG_DEBUG("outbound queue overloaded: " << pending_bytes()
+                       << " pending bytes");
+        m_overloaded = true;
+    }
+}
+
+void default_message_queue::notify_on_capacity(const actor_addr& listener,
+                                               any_tuple msg) {
+    if (!listener) return;
+    { // lifetime scope of guard
+        lock_guard<mutex> guard{m_listeners_mtx};
+        if (m_overloaded) {
+            m_listeners.emplace_back(listener, std::move(msg));
+            return;
+        }
+    }
+    auto ptr = detail::raw_access::get(listener);
+    ptr->enqueue({invalid_actor_addr, ptr}, std::move(msg));
+}
+
+void default_message_queue::unwritten_bytes(size_t num_bytes) {
+    m_unwritten_bytes = num_bytes;
+    if (!m_overloaded) return;
+    // flow control may have been disabled in the meantime
+    if (m_high_watermark > 0 && pending_bytes() > m_low_watermark) return;
+    vector<pair<actor_addr, any_tuple>> listeners;
+    { // lifetime scope of guard
+        lock_guard<mutex> guard{m_listeners_mtx};
+        m_overloaded = false;
+        listeners.swap(m_listeners);
+    }
+    CPPA_LOG_DEBUG("outbound queue drained, notify "
+                   << listeners.size() << " listeners");
+    for (auto& kvp : listeners) {
+        auto ptr = detail::raw_access::get(kvp.first);
+        ptr->enqueue({invalid_actor_addr, ptr}, std::move(kvp.second));
+    }
+}
+
+void default_message_queue::use_wire_format(wire_format format) {
+    m_format = format;
+}
+
+void default_message_queue::enable_compression() {
+    m_compress = true;
+}
+
+default_message_queue::type_table_ptr default_message_queue::outgoing_types() {
+    lock_guard<mutex> guard{m_types_mtx};
+    return m_types;
+}
+
+bool default_message_queue::serialize(util::buffer& buf,
+                                      type_lookup_table* types,
+                                      wire_format format,
+                                      const message_header& hdr,
+                                      const any_tuple& msg,
+                                      bool intern_types) {
+    uint32_t size = 0;
+    auto before = buf.size();
+    binary_serializer bs(&buf, m_namespace, types, format);
+    bs.intern_types(intern_types);
+    buf.write(sizeof(uint32_t), &size);
+    try { bs << hdr << msg; }
+    catch (exception& e) {
+        CPPA_LOG_ERROR(to_verbose_string(e));
+        cerr << "*** exception in default_message_queue::enqueue; "
+             << to_verbose_string(e)
+             << endl;
+        // drop the partially serialized message but keep
+        // preceding ADD_TYPE messages
+        buf.erase_trailing(buf.size() - before);
+        return false;
+    }
+    CPPA_LOG_DEBUG("serialized: " << to_string(hdr) << " " << to_string(msg));
+    size = (buf.size() - before) - sizeof(uint32_t);
+    if (format == wire_format::v2) size |= v2_flag;
+    // update size in buffer
+    memcpy(buf.offset_data(before), &size, sizeof(uint32_t));
+    if (m_compress) {
+        auto threshold = compression_threshold();
+        if (threshold > 0 && (size & ~v2_flag) >= threshold) {
+            compress(buf, before);
+        }
+    }
+    return true;
+}
+
+void default_message_queue::compress(util::buffer& buf, size_t offset) {
+    uint32_t size;
+    memcpy(&size, buf.offset_data(offset), sizeof(uint32_t));
+    auto payload = buf.offset_data(offset + sizeof(uint32_t));
+    uint32_t payload_size = size & ~v2_flag;
+    vector<char> tmp(sizeof(uint32_t) + util::lz4_compress_bound(payload_size));
+    memcpy(tmp.data(), &payload_size, sizeof(uint32_t));
+    auto compressed_size = sizeof(uint32_t)
+                         + util::lz4_compress(payload, payload_size,
+                                              tmp.data() + sizeof(uint32_t));
+    if (compressed_size >= payload_size) return; // incompressible
+    buf.erase_trailing(payload_size);
+    buf.write(compressed_size, tmp.data());
+    size = static_cast<uint32_t>(compressed_size)
+         | (size & v2_flag) | compressed_flag;
+    memcpy(buf.offset_data(offset), &size, sizeof(uint32_t));
+}
+
+void default_message_queue::add_type_if_needed(util::buffer& buf,
+                                               const string& tname) {
+    if (m_types->id_of(tname) == 0) {
+        type_table_ptr types{new type_lookup_table(*m_types)};
+        auto id = types->next_id();
+        auto imap = get_uniform_type_info_map();
+        types->emplace(id, imap->by_uniform_name(tname));
+        m_types = types;
+        auto msg = make_any_tuple(atom("ADD_TYPE"), id, tname);
+        string storage;
+        add_type_if_needed(buf, tuple_type_name(msg, storage));
+        serialize(buf, m_types.get(), wire_format::v1,
+                  {invalid_actor_addr, nullptr}, msg);
+    }
+}
+
+} } // namespace cppa::io
@@ -44,6 +44,7 @@ namespace { constexpr const char* s_names_table[] = {
 const char* as_string(std::uint32_t value) {
     if (value <= unhandled_sync_timeout) return s_names_table[value];
     if (value == remote_link_unreachable) return "remote_link_unreachable";
+    if (value == remote_overloaded) return "remote_overloaded";
     if (value >= user_defined) return "user_defined";
     return "illegal_exit_reason";
 }
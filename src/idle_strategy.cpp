@@ -0,0 +1,53 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include "cppa/detail/idle_strategy.hpp"
+
+namespace cppa { namespace detail {
+
+idle_strategy::idle_strategy(const settings& config)
+: m_config(config), m_parked(0), m_spins(0), m_parks(0), m_wakeups(0) { }
+
+void idle_strategy::wakeup() {
+    std::lock_guard<std::mutex> guard(m_mtx);
+    // a parked worker might have woken up in the meantime
+    if (m_parked.load() == 0) return;
+    m_wakeups.fetch_add(1, std::memory_order_relaxed);
+    m_cv.notify_one();
+}
+
+idle_strategy::statistics idle_strategy::stats() const {
+    return {m_spins.load(std::memory_order_relaxed),
+            m_parks.load(std::memory_order_relaxed),
+            m_wakeups.load(std::memory_order_relaxed)};
+}
+
+} } // namespace cppa::detail
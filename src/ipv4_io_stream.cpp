@@ -29,6 +29,7 @@
 
 
 #include <ios>
+#include <algorithm>
 #include <cstring>
 #include <errno.h>
 #include <iostream>
@@ -45,6 +46,7 @@
 #else
 #   include <netdb.h>
 #   include <unistd.h>
+#   include <sys/uio.h>
 #   include <sys/types.h>
 #   include <sys/socket.h>
 #   include <netinet/in.h>
@@ -55,6 +57,21 @@ namespace cppa { namespace io {
 
 using namespace ::cppa::detail::fd_util;
 
+namespace {
+
+// writing to a connection closed by the remote side must raise
+// an error rather than a SIGPIPE that terminates the process
+#ifdef MSG_NOSIGNAL
+constexpr int send_flags = MSG_NOSIGNAL;
+#else
+constexpr int send_flags = 0;
+#endif
+
+// number of slices passed to a single sendmsg() call
+constexpr size_t max_iov_per_call = 64;
+
+} // namespace <anonymous>
+
 ipv4_io_stream::ipv4_io_stream(native_socket_type fd) : m_fd(fd) { }
 
 ipv4_io_stream::~ipv4_io_stream() {
@@ -99,7 +116,8 @@ void ipv4_io_stream::write(const void* vbuf, size_t len) {
     auto buf = reinterpret_cast<const char*>(vbuf);
     size_t written = 0;
     while (written < len) {
-        auto send_result = ::send(m_fd, buf + written, len - written, 0);
+        auto send_result = ::send(m_fd, buf + written, len - written,
+                                  send_flags);
         handle_write_result(send_result, true);
         if (send_result > 0) {
             written += static_cast<size_t>(send_result);
@@ -118,9 +136,42 @@ void ipv4_io_stream::write(const void* vbuf, size_t len) {
 
 size_t ipv4_io_stream::write_some(const void* buf, size_t len) {
     CPPA_LOG_TRACE(CPPA_ARG(buf) << ", " << CPPA_ARG(len));
-    auto send_result = ::send(m_fd, reinterpret_cast<const char*>(buf), len, 0);
+    auto send_result = ::send(m_fd, reinterpret_cast<const char*>(buf), len,
+                              send_flags);
     handle_write_result(send_result, true);
-    return static_cast<size_t>(send_result);
+    return (send_result > 0) ? static_cast<size_t>(send_result) : 0;
+}
+
+size_t ipv4_io_stream::write_gathered(const output_slice* slices,
+                                      size_t num_slices) {
+    CPPA_LOG_TRACE(CPPA_ARG(num_slices));
+#   ifdef CPPA_WINDOWS
+    return stream::write_gathered(slices, num_slices);
+#   else
+    size_t result = 0;
+    iovec iov[max_iov_per_call];
+    while (num_slices > 0) {
+        auto n = std::min(num_slices, max_iov_per_call);
+        size_t requested = 0;
+        for (size_t i = 0; i < n; ++i) {
+            iov[i].iov_base = const_cast<void*>(slices[i].data);
+            iov[i].iov_len = slices[i].size;
+            requested += slices[i].size;
+        }
+        msghdr msg;
+        memset(&msg, 0, sizeof(msghdr));
+        msg.msg_iov = iov;
+        msg.msg_iovlen = n;
+        auto send_result = ::sendmsg(m_fd, &msg, send_flags);
+        handle_write_result(send_result, true);
+        if (send_result <= 0) return result;
+        result += static_cast<size_t>(send_result);
+        if (static_cast<size_t>(send_result) != requested) return result;
+        slices += n;
+        num_slices -= n;
+    }
+    return result;
+#   endif
 }
 
 io::stream_ptr ipv4_io_stream::from_native_socket(native_socket_type fd) {
@@ -29,6 +29,7 @@
 
 
 #include <string>
+#include <algorithm>
 #include "cppa/cppa.hpp"
 #include "cppa/atom.hpp"
 #include "cppa/logging.hpp"
@@ -162,6 +163,30 @@ void local_actor::delayed_send_tuple(message_priority prio,
                                   rel_time, std::move(msg));
 }
 
+std::uint64_t
+local_actor::cancellable_delayed_send_tuple(const channel& dest,
+                                            const util::duration& rtime,
+                                            any_tuple msg) {
+    return get_scheduler()->cancellable_delayed_send({address(), dest},
+                                                     rtime, std::move(msg));
+}
+
+void local_actor::cancel_delayed_send(std::uint64_t token) {
+    get_scheduler()->cancel_delayed_send(address(), token);
+}
+
+void local_actor::cancel_sync_timeout(message_id response_id) {
+    auto last = m_sync_timeouts.end();
+    auto i = std::find_if(m_sync_timeouts.begin(), last,
+                          [=](const std::pair<message_id, std::uint64_t>& p) {
+                              return p.first == response_id;
+                          });
+    if (i != last) {
+        cancel_delayed_send(i->second);
+        m_sync_timeouts.erase(i);
+    }
+}
+
 response_promise local_actor::make_response_promise() {
     auto n = m_current_node;
     response_promise result{address(), n->sender, n->mid.response_id()};
@@ -172,6 +197,8 @@ response_promise local_actor::make_response_promise() {
 void local_actor::cleanup(std::uint32_t reason) {
     CPPA_LOG_TRACE(CPPA_ARG(reason));
     m_subscriptions.clear();
+    for (auto& kvp : m_sync_timeouts) cancel_delayed_send(kvp.second);
+    m_sync_timeouts.clear();
     super::cleanup(reason);
 }
 
@@ -201,8 +228,10 @@ message_id local_actor::timed_sync_send_tuple_impl(message_priority mp,
     if (mp == message_priority::high) nri = nri.with_high_priority();
     dest->enqueue({address(), dest, nri}, std::move(what));
     auto rri = nri.response_id();
-    get_scheduler()->delayed_send({address(), this, rri}, rtime,
-                                  make_any_tuple(sync_timeout_msg{}));
+    auto token = get_scheduler()->cancellable_delayed_send(
+                     {address(), this, rri}, rtime,
+                     make_any_tuple(sync_timeout_msg{}));
+    m_sync_timeouts.emplace_back(rri, token);
     return rri;
 }
 
@@ -0,0 +1,197 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+#include <cstdint>
+#include <cstring>
+
+#include "cppa/util/lz4.hpp"
+
+namespace cppa { namespace util {
+
+namespace {
+
+typedef std::uint8_t byte;
+
+// a match is encoded as offset (2 bytes) + length (at least 4 bytes)
+constexpr size_t min_match = 4;
+constexpr size_t max_offset = 65535;
+
+// the format requires the last 5 bytes to be literals and
+// the last match to start at least 12 bytes before the end
+constexpr size_t last_literals = 5;
+constexpr size_t match_limit = 12;
+
+constexpr int hash_log = 12;
+
+inline std::uint32_t read32(const byte* ptr) {
+    std::uint32_t result;
+    memcpy(&result, ptr, sizeof(std::uint32_t));
+    return result;
+}
+
+inline std::uint32_t hash(std::uint32_t sequence) {
+    return (sequence * 2654435761U) >> (32 - hash_log);
+}
+
+// writes lengths >= 15 as sequence of 255 bytes plus remainder
+inline byte* write_length(byte* op, size_t length) {
+    for ( ; length >= 255; length -= 255) *op++ = 255;
+    *op++ = static_cast<byte>(length);
+    return op;
+}
+
+// reads the remainder of a length field starting with 15,
+// returns false if the input ends before the length does
+inline bool read_length(const byte*& ip, const byte* iend, size_t& length) {
+    byte b;
+    do {
+        if (ip == iend) return false;
+        b = *ip++;
+        length += b;
+    }
+    while (b == 255);
+    return true;
+}
+
+byte* write_sequence(byte* op, const byte* literals, size_t num_literals,
+                     size_t offset, size_t match_length) {
+    auto token = op++;
+    if (num_literals >= 15) {
+        *token = 15 << 4;
+        op = write_length(op, num_literals - 15);
+    }
+    else *token = static_cast<byte>(num_literals << 4);
+    memcpy(op, literals, num_literals);
+    op += num_literals;
+    if (match_length == 0) return op; // last sequence
+    *op++ = static_cast<byte>(offset & 0xFF);
+    *op++ = static_cast<byte>(offset >> 8);
+    match_length -= min_match;
+    if (match_length >= 15) {
+        *token |= 15;
+        op = write_length(op, match_length - 15);
+    }
+    else *token |= static_cast<byte>(match_length);
+    return op;
+}
+
+} // namespace <anonymous>
+
+size_t lz4_compress_bound(size_t num_bytes) {
+    return num_bytes + (num_bytes / 255) + 16;
+}
+
+size_t lz4_compress(const void* data, size_t num_bytes, void* storage) {
+    auto src = reinterpret_cast<const byte*>(data);
+    auto op = reinterpret_cast<byte*>(storage);
+    size_t anchor = 0;
+    if (num_bytes > match_limit) {
+        // positions of the last occurrence of each hashed 4-byte sequence
+        std::uint32_t table[1 << hash_log];
+        memset(table, 0, sizeof(table));
+        auto limit = num_bytes - match_limit;
+        size_t pos = 1;
+        table[hash(read32(src))] = 0;
+        while (pos < limit) {
+            auto sequence = read32(src + pos);
+            auto& entry = table[hash(sequence)];
+            size_t candidate = entry;
+            entry = static_cast<std::uint32_t>(pos);
+            if (pos - candidate > max_offset || read32(src + candidate) != sequence) {
+                // skip faster through incompressible data
+                pos += 1 + ((pos - anchor) >> 6);
+                continue;
+            }
+            // extend match backwards over pending literals ...
+            while (pos > anchor && candidate > 0 && src[pos - 1] == src[candidate - 1]) {
+                --pos;
+                --candidate;
+            }
+            // ... and forwards up to the last literals
+            size_t length = min_match;
+            auto max_length = num_bytes - last_literals - pos;
+            while (length < max_length && src[pos + length] == src[candidate + length]) {
+                ++length;
+            }
+            op = write_sequence(op, src + anchor, pos - anchor,
+                                pos - candidate, length);
+            pos += length;
+            anchor = pos;
+        }
+    }
+    op = write_sequence(op, src + anchor, num_bytes - anchor, 0, 0);
+    return static_cast<size_t>(op - reinterpret_cast<byte*>(storage));
+}
+
+bool lz4_decompress(const void* data, size_t num_bytes,
+                    void* storage, size_t storage_size) {
+    auto ip = reinterpret_cast<const byte*>(data);
+    auto iend = ip + num_bytes;
+    auto dst = reinterpret_cast<byte*>(storage);
+    auto op = dst;
+    auto oend = dst + storage_size;
+    while (ip < iend) {
+        auto token = *ip++;
+        size_t num_literals = token >> 4;
+        if (num_literals == 15 && !read_length(ip, iend, num_literals)) {
+            return false;
+        }
+        if (   static_cast<size_t>(iend - ip) < num_literals
+            || static_cast<size_t>(oend - op) < num_literals) {
+            return false;
+        }
+        memcpy(op, ip, num_literals);
+        ip += num_literals;
+        op += num_literals;
+        if (ip == iend) break; // last sequence has no match
+        if (iend - ip < 2) return false;
+        size_t offset = ip[0] | (static_cast<size_t>(ip[1]) << 8);
+        ip += 2;
+        if (offset == 0 || offset > static_cast<size_t>(op - dst)) {
+            return false;
+        }
+        size_t length = token & 0x0F;
+        if (length == 15 && !read_length(ip, iend, length)) return false;
+        length += min_match;
+        if (static_cast<size_t>(oend - op) < length) return false;
+        auto match = op - offset;
+        if (offset >= length) {
+            memcpy(op, match, length);
+            op += length;
+        }
+        else {
+            // overlapping copy repeats the last offset bytes
+            for (size_t i = 0; i < length; ++i) *op++ = *match++;
+        }
+    }
+    return op == oend;
+}
+
+} } // namespace cppa::util
@@ -29,10 +29,9 @@
 
 
 #include <vector>
-#include <typeinfo>
+#include <pthread.h>
 
 #include "cppa/detail/memory.hpp"
-#include "cppa/mailbox_element.hpp"
 
 using namespace std;
 
@@ -53,39 +52,32 @@ pthread_once_t s_key_once = PTHREAD_ONCE_INIT;
 
 memory_cache::~memory_cache() { }
 
-typedef map<const type_info*, unique_ptr<memory_cache> > cache_map;
+typedef vector<memory_cache*> cache_list;
 
-void cache_map_destructor(void* ptr) {
-    if (ptr) delete reinterpret_cast<cache_map*>(ptr);
-}
-
-void make_cache_map() {
-    pthread_key_create(&s_key, cache_map_destructor);
-}
-
-cache_map& get_cache_map() {
-    pthread_once(&s_key_once, make_cache_map);
-    auto cache = reinterpret_cast<cache_map*>(pthread_getspecific(s_key));
-    if (!cache) {
-        cache = new cache_map;
-        pthread_setspecific(s_key, cache);
-        // insert default types
-        unique_ptr<memory_cache> tmp(new basic_memory_cache<mailbox_element>);
-        cache->insert(make_pair(&typeid(mailbox_element), move(tmp)));
+void cache_list_destructor(void* ptr) {
+    if (ptr) {
+        auto caches = reinterpret_cast<cache_list*>(ptr);
+        for (auto mc : *caches) {
+            mc->close();
+            mc->deref();
+        }
+        delete caches;
     }
-    return *cache;
 }
 
-memory_cache* memory::get_cache_map_entry(const type_info* tinf) {
-    auto& cache = get_cache_map();
-    auto i = cache.find(tinf);
-    if (i != cache.end()) return i->second.get();
-    return nullptr;
+void make_cache_list() {
+    pthread_key_create(&s_key, cache_list_destructor);
 }
 
-void memory::add_cache_map_entry(const type_info* tinf, memory_cache* instance) {
-    auto& cache = get_cache_map();
-    cache[tinf].reset(instance);
+void add_thread_local_cache(memory_cache* ptr) {
+    pthread_once(&s_key_once, make_cache_list);
+    auto caches = reinterpret_cast<cache_list*>(pthread_getspecific(s_key));
+    if (!caches) {
+        caches = new cache_list;
+        pthread_setspecific(s_key, caches);
+    }
+    ptr->ref();
+    caches->push_back(ptr);
 }
 
 instance_wrapper::~instance_wrapper() { }
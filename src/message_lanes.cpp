@@ -0,0 +1,73 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include "cppa/config.hpp"
+
+#include "cppa/io/message_lanes.hpp"
+
+namespace cppa { namespace io {
+
+constexpr size_t message_lanes::max_lanes;
+
+constexpr std::uint32_t message_lanes::handshake_marker;
+
+constexpr std::uint32_t message_lanes::type_ids_per_lane;
+
+message_lanes::message_lanes(actor_namespace* ns, size_t num_lanes)
+: local_offer(0), remote_offer(0)
+, m_states(new std::atomic<int>[num_lanes]) {
+    CPPA_REQUIRE(num_lanes > 0 && num_lanes <= max_lanes);
+    m_queues.reserve(num_lanes);
+    for (size_t i = 0; i < num_lanes; ++i) {
+        auto first_type_id = static_cast<std::uint32_t>(i) * type_ids_per_lane;
+        m_queues.emplace_back(new default_message_queue(ns, first_type_id));
+        // lane 0 is served by the connection that created this lane set
+        m_states[i] = (i == 0) ? active : pending;
+    }
+}
+
+size_t message_lanes::select(const message_header& hdr,
+                             actor_id receiver) const {
+    auto num_lanes = m_queues.size();
+    if (num_lanes == 1) return 0;
+    if (hdr.id.is_high_priority()) return num_lanes - 1;
+    std::uint64_t sender = hdr.sender ? hdr.sender.id() : 0;
+    // mix both IDs, because actor IDs are assigned sequentially
+    auto h = ((sender << 32) | receiver) * 0x9E3779B97F4A7C15ull;
+    return static_cast<size_t>(h >> 32) % (num_lanes - 1);
+}
+
+bool message_lanes::transition(size_t lane, lane_state from, lane_state to) {
+    int expected = from;
+    return m_states[lane].compare_exchange_strong(expected, to);
+}
+
+} } // namespace cppa::io
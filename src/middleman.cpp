@@ -28,15 +28,22 @@
 \******************************************************************************/
 
 
+#include <map>
+#include <mutex>
 #include <tuple>
+#include <atomic>
 #include <cerrno>
 #include <memory>
+#include <thread>
+#include <vector>
 #include <cstring>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
 #include <stdexcept>
 
 #include "cppa/on.hpp"
+#include "cppa/cppa.hpp"
 #include "cppa/actor.hpp"
 #include "cppa/match.hpp"
 #include "cppa/config.hpp"
@@ -74,91 +81,146 @@
 #   include <fcntl.h>
 #endif
 
+#ifdef CPPA_LINUX
+#   include <sys/eventfd.h>
+#endif
+
 using namespace std;
 
 namespace cppa { namespace io {
 
+namespace {
+
+// flow control settings for new outbound queues, see remote_watermarks()
+std::mutex s_flow_control_mtx;
+size_t s_low_watermark = 0;
+size_t s_high_watermark = 0;
+overflow_policy s_overflow_policy = overflow_policy::drop_low_priority;
+
+// returns the read and the write handle for waking up an event loop;
+// on Linux, both handles refer to the same eventfd
+pair<native_socket_type, native_socket_type> create_wakeup_handles() {
+#   ifdef CPPA_LINUX
+    auto fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) { CPPA_CRITICAL("cannot create eventfd"); }
+    return {fd, fd};
+#   else
+    auto pipefds = detail::fd_util::create_pipe();
+    detail::fd_util::nonblocking(pipefds.first, true);
+    return pipefds;
+#   endif
+}
+
 void notify_queue_event(native_socket_type fd) {
-    char dummy = 0;
     // on unix, we have file handles, on windows, we actually have sockets
-#   ifdef CPPA_WINDOWS
+#   if defined(CPPA_LINUX)
+    uint64_t one = 1;
+    auto res = ::write(fd, &one, sizeof(one));
+#   elif defined(CPPA_WINDOWS)
+    char dummy = 0;
     auto res = ::send(fd, &dummy, sizeof(dummy), 0);
 #   else
+    char dummy = 0;
     auto res = ::write(fd, &dummy, sizeof(dummy));
 #   endif
     // ignore result: an "error" means our middleman has been shut down
     static_cast<void>(res);
 }
 
-size_t num_queue_events(native_socket_type fd) {
+// resets the read handle returned by create_wakeup_handles()
+void clear_queue_events(native_socket_type fd) {
+#   ifdef CPPA_LINUX
+    uint64_t dummy;
+    // reading an eventfd resets its counter
+    auto read_result = ::read(fd, &dummy, sizeof(dummy));
+#   else
     static constexpr size_t num_dummies = 64;
     char dummies[num_dummies];
-    // on unix, we have file handles, on windows, we actually have sockets
-#   ifdef CPPA_WINDOWS
-    auto read_result = ::recv(fd, dummies, num_dummies, 0);
-#   else
-    auto read_result = ::read(fd, dummies, num_dummies);
+    ssize_t read_result;
+    do {
+        // on unix, we have file handles, on windows, we actually have sockets
+#       ifdef CPPA_WINDOWS
+        read_result = ::recv(fd, dummies, num_dummies, 0);
+#       else
+        read_result = ::read(fd, dummies, num_dummies);
+#       endif
+    }
+    while (read_result > 0);
 #   endif
-    if (read_result < 0) {
-        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-            // try again later
-            return 0;
-        }
-        else {
-            CPPA_LOGF_ERROR("cannot read from pipe");
-            CPPA_CRITICAL("cannot read from pipe");
-        }
+    if (read_result < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+        CPPA_LOGF_ERROR("cannot read from pipe");
+        CPPA_CRITICAL("cannot read from pipe");
     }
-    return static_cast<size_t>(read_result);
 }
 
-class middleman_event {
+} // namespace <anonymous>
 
-    friend class intrusive::single_reader_queue<middleman_event>;
+typedef intrusive::single_reader_queue<middleman_event, detail::disposer>
+        middleman_queue;
 
- public:
-
-    template<typename Arg>
-    middleman_event(Arg&& arg) : next(nullptr), fun(forward<Arg>(arg)) { }
+/*
+ * An event loop of the middleman with its own thread and event handler.
+ */
+struct middleman_loop_data {
 
-    inline void operator()() { fun(); }
+    middleman_loop_data(size_t loop_id) : id(loop_id), done(false) { }
 
- private:
+    size_t id;
+    bool done;
+    thread loop_thread;
+    native_socket_type wakeup_out;
+    native_socket_type wakeup_in;
+    middleman_queue queue;
+    std::unique_ptr<middleman_event_handler> handler;
 
-    middleman_event* next;
-    function<void()> fun;
+    // all peers served by this loop, identified by node and lane
+    std::map<std::pair<node_id, size_t>, peer*> peers;
 
 };
 
+namespace {
+
+// the event loop running in the calling thread (if any)
+__thread middleman_loop_data* t_loop = nullptr;
+
+inline middleman_event_handler* loop_handler() {
+    CPPA_REQUIRE(t_loop != nullptr);
+    return t_loop->handler.get();
+}
+
+} // namespace <anonymous>
+
 void middleman::continue_writer(continuable* ptr) {
     CPPA_LOG_TRACE(CPPA_ARG(ptr));
-    m_handler->add_later(ptr, event::write);
+    loop_handler()->add_later(ptr, event::write);
 }
 
 void middleman::stop_writer(continuable* ptr) {
     CPPA_LOG_TRACE(CPPA_ARG(ptr));
-    m_handler->erase_later(ptr, event::write);
+    loop_handler()->erase_later(ptr, event::write);
 }
 
 bool middleman::has_writer(continuable* ptr) {
-    return m_handler->has_writer(ptr);
+    return loop_handler()->has_writer(ptr);
 }
 
 void middleman::continue_reader(continuable* ptr) {
     CPPA_LOG_TRACE(CPPA_ARG(ptr));
-    m_handler->add_later(ptr, event::read);
+    loop_handler()->add_later(ptr, event::read);
 }
 
 void middleman::stop_reader(continuable* ptr) {
     CPPA_LOG_TRACE(CPPA_ARG(ptr));
-    m_handler->erase_later(ptr, event::read);
+    loop_handler()->erase_later(ptr, event::read);
 }
 
 bool middleman::has_reader(continuable* ptr) {
-    return m_handler->has_reader(ptr);
+    return loop_handler()->has_reader(ptr);
 }
 
-typedef intrusive::single_reader_queue<middleman_event> middleman_queue;
+class middleman_impl;
+
+void middleman_loop(middleman_impl* impl, middleman_loop_data* loop);
 
 /*
  * A middleman also implements a "namespace" for actors.
@@ -166,51 +228,18 @@ typedef intrusive::single_reader_queue<middleman_event> middleman_queue;
 class middleman_impl : public middleman {
 
     friend class middleman;
-    friend void middleman_loop(middleman_impl*);
 
  public:
 
-    middleman_impl() : m_done(false) { }
+    middleman_impl() : m_next_loop(0) { }
 
-    void run_later(function<void()> fun) override {
-        m_queue.enqueue(new middleman_event(move(fun)));
-        atomic_thread_fence(memory_order_seq_cst);
-        notify_queue_event(m_pipe_in);
-    }
 
     bool register_peer(const node_id& node, peer* ptr) override {
-        CPPA_LOG_TRACE("node = " << to_string(node) << ", ptr = " << ptr);
-        auto& entry = m_peers[node];
-        if (entry.impl == nullptr) {
-            if (entry.queue == nullptr) entry.queue.emplace();
-            ptr->set_queue(entry.queue);
-            entry.impl = ptr;
-            if (!entry.queue->empty()) {
-                auto tmp = entry.queue->pop();
-                ptr->enqueue(tmp.first, tmp.second);
-            }
-            CPPA_LOG_INFO("peer " << to_string(node) << " added");
-            return true;
-        }
-        else {
-            CPPA_LOG_WARNING("peer " << to_string(node) << " already defined, "
-                             "multiple calls to remote_actor()?");
-            return false;
-        }
+        return register_peer(node, ptr, false);
     }
 
     peer* get_peer(const node_id& node) override {
-        CPPA_LOG_TRACE(CPPA_TARG(node, to_string));
-        auto i = m_peers.find(node);
-        // future work (?): we *could* try to be smart here and try to
-        // route all messages to node via other known peers in the network
-        // if i->second.impl == nullptr
-        if (i != m_peers.end() && i->second.impl != nullptr) {
-            CPPA_LOG_DEBUG("result = " << i->second.impl);
-            return i->second.impl;
-        }
-        CPPA_LOG_DEBUG("result = nullptr");
-        return nullptr;
+        return get_peer(node, 0);
     }
 
     void del_acceptor(peer_acceptor* ptr) override {
@@ -229,17 +258,47 @@ class middleman_impl : public middleman {
     void deliver(const node_id& node,
                  const message_header& hdr,
                  any_tuple msg                  ) override {
-        auto& entry = m_peers[node];
-        if (entry.impl) {
-            CPPA_REQUIRE(entry.queue != nullptr);
-            if (!entry.impl->has_unwritten_data()) {
-                CPPA_REQUIRE(entry.queue->empty());
-                entry.impl->enqueue(hdr, msg);
-                return;
+        if (outbound_queue(node)->enqueue(hdr, msg)) {
+            flush_later(new node_id(node));
+        }
+    }
+
+    message_lanes_ptr outbound_lanes(const node_id& node) override {
+        lock_guard<mutex> guard(m_nodes_mtx);
+        auto& result = m_outbound[node];
+        if (result == nullptr) {
+            result.reset(new message_lanes(&m_namespace, remote_connections()));
+            lock_guard<mutex> fc_guard{s_flow_control_mtx};
+            for (size_t i = 0; i < result->size(); ++i) {
+                result->queue(i)->watermarks(s_low_watermark,
+                                             s_high_watermark,
+                                             s_overflow_policy);
             }
         }
-        if (entry.queue == nullptr) entry.queue.emplace();
-        entry.queue->emplace(hdr, msg);
+        return result;
+    }
+
+    void flush_later(const node_id_ptr& node, size_t lane = 0) override {
+        post(*m_loops[loop_index(*node, lane)], new_event([=] {
+            flush(*node, lane);
+        }));
+    }
+
+    void offer_lanes(const node_id& node, std::uint32_t mask) override {
+        CPPA_LOG_TRACE(CPPA_TARG(node, to_string) << ", " << CPPA_ARG(mask));
+        auto lanes = outbound_lanes(node);
+        // lane 0 is always available
+        lanes->local_offer = (mask & lanes->all()) | 0x01;
+        auto p = get_peer(node);
+        if (p) p->enqueue(make_any_tuple(atom("LANES"), lanes->local_offer));
+        settle_lanes(node, *lanes);
+    }
+
+    void accept_lanes(const node_id& node, std::uint32_t mask) override {
+        CPPA_LOG_TRACE(CPPA_TARG(node, to_string) << ", " << CPPA_ARG(mask));
+        auto lanes = outbound_lanes(node);
+        lanes->remote_offer = mask | 0x01;
+        settle_lanes(node, *lanes);
     }
 
     void last_proxy_exited(peer* pptr) override {
@@ -254,23 +313,46 @@ class middleman_impl : public middleman {
 
     void new_peer(const input_stream_ptr& in,
                   const output_stream_ptr& out,
-                  const node_id_ptr& node = nullptr) override {
+                  const node_id_ptr& node = nullptr,
+                  size_t lane = 0) override {
         CPPA_LOG_TRACE("");
-        auto ptr = new peer(this, in, out, node);
-        continue_reader(ptr);
-        if (node) register_peer(*node, ptr);
+        if (node) add_peer(in, out, node, lane);
+        else {
+            // the node of an incoming connection is unknown until
+            // its handshake is done, hence we pick a loop round robin
+            auto& loop = *m_loops[m_next_loop++ % m_loops.size()];
+            if (t_loop == &loop) add_peer(in, out, nullptr, 0);
+            else post(loop, new_event([=] { add_peer(in, out, nullptr, 0); }));
+        }
     }
 
     void del_peer(peer* pptr) override {
         CPPA_LOG_TRACE(CPPA_ARG(pptr));
-        auto i = m_peers.find(pptr->node());
-        if (i != m_peers.end()) {
-            CPPA_LOG_DEBUG_IF(i->second.impl != pptr,
-                              "node " << to_string(pptr->node())
-                              << " does not exist in m_peers");
-            if (i->second.impl == pptr) {
-                m_peers.erase(i);
-            }
+        auto& peers = current_loop().peers;
+        auto key = make_pair(pptr->node(), pptr->lane());
+        auto i = peers.find(key);
+        if (i == peers.end()) return;
+        CPPA_LOG_DEBUG_IF(i->second != pptr,
+                          "node " << to_string(pptr->node())
+                          << " does not exist in m_peers");
+        if (i->second != pptr) return;
+        peers.erase(i);
+        bool connected = pptr->connected_lane();
+        { // lifetime scope of guard
+            lock_guard<mutex> guard(m_nodes_mtx);
+            m_peer_loops.erase(key);
+            if (connected) m_outbound.erase(pptr->node());
+        }
+        if (connected) {
+            // lanes of a node are used as a unit, i.e., the
+            // connection to the node is lost if any lane fails
+            close_peers(pptr->node());
+        }
+        else if (pptr->m_lanes->transition(pptr->lane(),
+                                           message_lanes::pending,
+                                           message_lanes::merged)) {
+            // the remote node did not accept this lane
+            flush_later(new node_id(pptr->node()), pptr->lane());
         }
     }
 
@@ -293,7 +375,6 @@ class middleman_impl : public middleman {
         }
 #       endif
         m_node = compute_node_id();
-        m_handler = middleman_event_handler::create();
         m_namespace.set_proxy_factory([=](actor_id aid, node_id_ptr ptr) {
             return make_counted<remote_actor_proxy>(aid, std::move(ptr), this);
         });
@@ -305,22 +386,36 @@ class middleman_impl : public middleman {
                                    m_node,
                                    aid));
         });
-        auto pipefds = detail::fd_util::create_pipe();
-        m_pipe_out = pipefds.first;
-        m_pipe_in = pipefds.second;
-        detail::fd_util::nonblocking(m_pipe_out, true);
+        for (size_t i = 0; i < middleman_threads(); ++i) {
+            m_loops.emplace_back(new middleman_loop_data(i));
+            auto& loop = *m_loops.back();
+            loop.handler = middleman_event_handler::create();
+            auto fds = create_wakeup_handles();
+            loop.wakeup_out = fds.first;
+            loop.wakeup_in = fds.second;
+        }
         // start threads
-        m_thread = thread([this] { middleman_loop(this); });
+        for (auto& loop : m_loops) {
+            auto lptr = loop.get();
+            loop->loop_thread = thread([=] { middleman_loop(this, lptr); });
+        }
     }
 
     void destroy() override {
-        run_later([this] {
-            CPPA_LOGM_TRACE("destroy$helper", "");
-            this->m_done = true;
-        });
-        m_thread.join();
-        closesocket(m_pipe_out);
-        closesocket(m_pipe_in);
+        for (auto& loop : m_loops) {
+            auto lptr = loop.get();
+            post(*lptr, new_event([lptr] {
+                CPPA_LOGM_TRACE("destroy$helper", "");
+                lptr->done = true;
+            }));
+        }
+        for (auto& loop : m_loops) loop->loop_thread.join();
+        for (auto& loop : m_loops) {
+            closesocket(loop->wakeup_out);
+            if (loop->wakeup_in != loop->wakeup_out) {
+                closesocket(loop->wakeup_in);
+            }
+        }
 #       ifdef CPPA_WINDOWS
         WSACleanup();
 #       endif
@@ -338,26 +433,233 @@ class middleman_impl : public middleman {
         return new cppa::node_id(getpid(), node_id);
     }
 
-    inline void quit() { m_done = true; }
+    void enqueue(middleman_event* ev) override {
+        post(*m_loops.front(), ev);
+    }
+
+    void enqueue(const node_id& node, middleman_event* ev) override {
+        post(*m_loops[loop_index(node)], ev);
+    }
+
+    void post(middleman_loop_data& loop, middleman_event* ev) {
+        // the loop drains its queue completely per wakeup,
+        // hence we only need to wake it up if the queue was empty
+        if (loop.queue.enqueue(ev) == intrusive::first_enqueued) {
+            notify_queue_event(loop.wakeup_in);
+        }
+    }
+
+    inline middleman_loop_data& current_loop() {
+        CPPA_REQUIRE(t_loop != nullptr);
+        return *t_loop;
+    }
+
+    // creates a new peer in the calling event loop
+    void add_peer(const input_stream_ptr& in,
+                  const output_stream_ptr& out,
+                  const node_id_ptr& node,
+                  size_t lane) {
+        auto ptr = new peer(this, in, out, node, lane);
+        continue_reader(ptr);
+        if (node) register_peer(*node, ptr, true);
+    }
+
+    // registers a peer in the calling event loop; the node initiating
+    // the connection of an additional lane activates it once both nodes
+    // agreed on the lanes, whereas the accepting node activates it
+    // as soon as the peer is registered
+    bool register_peer(const node_id& node, peer* ptr, bool initiator) {
+        CPPA_LOG_TRACE("node = " << to_string(node) << ", ptr = " << ptr
+                       << ", lane = " << ptr->lane());
+        auto& loop = current_loop();
+        auto lane = ptr->lane();
+        auto lanes = outbound_lanes(node);
+        if (lane >= lanes->size()) {
+            CPPA_LOG_INFO("lane " << lane << " exceeds number of lanes");
+            return false;
+        }
+        if (lane > 0 && lanes->state(lane) != message_lanes::pending) {
+            CPPA_LOG_INFO("lane " << lane << " is not pending");
+            return false;
+        }
+        auto key = make_pair(node, lane);
+        { // lifetime scope of guard
+            lock_guard<mutex> guard(m_nodes_mtx);
+            auto i = m_peer_loops.find(key);
+            if (i != m_peer_loops.end() && i->second != loop.id) {
+                CPPA_LOG_WARNING("peer " << to_string(node) << " already "
+                                 "defined in loop " << i->second
+                                 << ", multiple calls to remote_actor()?");
+                return false;
+            }
+            m_peer_loops.insert(make_pair(key, loop.id));
+        }
+        auto& entry = loop.peers[key];
+        if (entry != nullptr) {
+            CPPA_LOG_WARNING("peer " << to_string(node) << " already defined, "
+                             "multiple calls to remote_actor()?");
+            return false;
+        }
+        entry = ptr;
+        ptr->m_lanes = lanes;
+        ptr->set_queue(lanes->queue(lane));
+        if (lane == 0) {
+            // send all messages enqueued before the connection was established
+            ptr->flush_queue();
+            ptr->announce_protocol();
+            // the initiating node offers its lanes once they are connected
+            if (!initiator) offer_lanes(node, lanes->all());
+            CPPA_LOG_INFO("peer " << to_string(node) << " added");
+        }
+        else if (!initiator) {
+            lanes->transition(lane, message_lanes::pending,
+                              message_lanes::active);
+            ptr->announce_protocol();
+            CPPA_LOG_INFO("lane " << lane << " of peer "
+                          << to_string(node) << " added");
+        }
+        return true;
+    }
+
+    peer* get_peer(const node_id& node, size_t lane) {
+        CPPA_LOG_TRACE(CPPA_TARG(node, to_string) << ", " << CPPA_ARG(lane));
+        auto& peers = current_loop().peers;
+        auto i = peers.find(make_pair(node, lane));
+        // future work (?): we *could* try to be smart here and try to
+        // route all messages to node via other known peers in the network
+        // if i->second.impl == nullptr
+        if (i != peers.end() && i->second != nullptr) {
+            CPPA_LOG_DEBUG("result = " << i->second);
+            return i->second;
+        }
+        CPPA_LOG_DEBUG("result = nullptr");
+        return nullptr;
+    }
+
+    // sends all messages of lane, must be called
+    // from the event loop given by loop_index()
+    void flush(const node_id& node, size_t lane) {
+        // if there is no connection yet, the queue is
+        // flushed as soon as the peer is registered
+        if (lane == 0) {
+            auto p = get_peer(node, 0);
+            if (p) p->flush_queue();
+            return;
+        }
+        auto lanes = outbound_lanes(node);
+        switch (lanes->state(lane)) {
+            case message_lanes::pending:
+                // flushed once both nodes agreed on the lanes
+                break;
+            case message_lanes::active: {
+                auto p = get_peer(node, lane);
+                if (p) p->flush_queue();
+                break;
+            }
+            case message_lanes::merged: {
+                auto p = get_peer(node, 0);
+                if (p) p->flush_queue(*lanes->queue(lane));
+                break;
+            }
+        }
+    }
+
+    // activates or merges all pending lanes once both offers are known,
+    // must be called from the event loop serving lane 0 of node
+    void settle_lanes(const node_id& node, message_lanes& lanes) {
+        if (lanes.local_offer == 0 || lanes.remote_offer == 0) return;
+        auto agreed = lanes.local_offer & lanes.remote_offer;
+        for (size_t lane = 1; lane < lanes.size(); ++lane) {
+            if (lanes.state(lane) != message_lanes::pending) continue;
+            if (agreed & (std::uint32_t{1} << lane)) {
+                // the initiating node serves its lanes in the loop of lane 0,
+                // the accepting node activates lanes on registration
+                auto p = get_peer(node, lane);
+                if (!p || !lanes.transition(lane, message_lanes::pending,
+                                            message_lanes::active)) {
+                    continue;
+                }
+                p->announce_protocol();
+                p->flush_queue();
+            }
+            else if (lanes.transition(lane, message_lanes::pending,
+                                      message_lanes::merged)) {
+                auto p = get_peer(node, lane);
+                if (p) {
+                    stop_reader(p);
+                    stop_writer(p);
+                }
+                { // lifetime scope of guard
+                    lock_guard<mutex> guard(m_nodes_mtx);
+                    m_peer_loops.erase(make_pair(node, lane));
+                }
+                flush(node, lane);
+            }
+        }
+    }
+
+    // closes all connections to node
+    void close_peers(const node_id& node) {
+        std::vector<std::pair<size_t, size_t>> targets; // (lane, loop)
+        { // lifetime scope of guard
+            lock_guard<mutex> guard(m_nodes_mtx);
+            auto i = m_peer_loops.lower_bound(make_pair(node, size_t{0}));
+            for (; i != m_peer_loops.end() && i->first.first == node; ++i) {
+                targets.emplace_back(i->first.second, i->second);
+            }
+        }
+        auto nptr = make_counted<node_id>(node);
+        for (auto& t : targets) {
+            auto lane = t.first;
+            post(*m_loops[t.second], new_event([=] {
+                auto p = get_peer(*nptr, lane);
+                if (p) {
+                    stop_reader(p);
+                    stop_writer(p);
+                }
+            }));
+        }
+    }
 
-    inline bool done() const { return m_done; }
+    // returns the index of the loop serving lane 0 of node
+    size_t loop_index(const node_id& node) {
+        return loop_index(node, 0);
+    }
 
-    bool m_done;
+    // returns the index of the loop serving lane of node, lanes
+    // without connection are served by the loop of lane 0
+    size_t loop_index(const node_id& node, size_t lane) {
+        if (m_loops.size() == 1) return 0;
+        { // lifetime scope of guard
+            lock_guard<mutex> guard(m_nodes_mtx);
+            auto i = m_peer_loops.find(make_pair(node, lane));
+            if (i == m_peer_loops.end() && lane != 0) {
+                i = m_peer_loops.find(make_pair(node, size_t{0}));
+            }
+            if (i != m_peer_loops.end()) return i->second;
+        }
+        // not connected (yet), distribute nodes by their ID
+        size_t result = node.process_id();
+        for (auto byte : node.host_id()) result = result * 31 + byte;
+        return result % m_loops.size();
+    }
 
-    middleman_event_handler& handler();
+    std::vector<std::unique_ptr<middleman_loop_data>> m_loops;
 
-    thread m_thread;
-    native_socket_type m_pipe_out;
-    native_socket_type m_pipe_in;
-    middleman_queue m_queue;
+    // used to distribute incoming connections
+    std::atomic<size_t> m_next_loop;
 
-    struct peer_entry {
-        peer* impl;
-        default_message_queue_ptr queue;
-    };
+    // guards m_peer_loops and m_outbound
+    mutex m_nodes_mtx;
 
+    // maps each connected lane of a node to the index of its loop
+    std::map<std::pair<node_id, size_t>, size_t> m_peer_loops;
+
+    // outbound lanes of all known nodes
+    std::map<node_id, message_lanes_ptr> m_outbound;
+
+    // accessed only from the first loop
     std::map<actor_addr, std::vector<peer_acceptor*>> m_acceptors;
-    std::map<node_id, peer_entry> m_peers;
 
 };
 
@@ -376,19 +678,17 @@ class middleman_overseer : public continuable {
 
     continue_reading_result continue_reading() {
         CPPA_LOG_TRACE("");
-        // on MacOS, recv() on a pipe fd will fail,
-        // on Windows, our pipe is actually composed of two sockets
-        // and there's no read() function to read from sockets
-        auto events = num_queue_events(read_handle());
-        CPPA_LOG_DEBUG("read " << events << " messages from queue");
-        for (size_t i = 0; i < events; ++i) {
-            unique_ptr<middleman_event> msg(m_queue.try_pop());
-            if (!msg) {
-                CPPA_LOG_ERROR("nullptr dequeued");
-                CPPA_CRITICAL("nullptr dequeued");
-            }
+        // reset the wakeup handle *before* draining the queue, because
+        // any event enqueued after our last fetch signals it again
+        clear_queue_events(read_handle());
+        auto f = [](middleman_event* ev) {
             CPPA_LOGF_DEBUG("execute run_later functor");
-            (*msg)();
+            ev->run();
+            detail::disposer d;
+            d(ev);
+        };
+        while (m_queue.drain(f) > 0) {
+            // repeat until no new events were enqueued
         }
         return read_continue_later;
     }
@@ -405,16 +705,17 @@ class middleman_overseer : public continuable {
 
 middleman::~middleman() { }
 
-void middleman_loop(middleman_impl* impl) {
-    middleman_event_handler* handler = impl->m_handler.get();
-    CPPA_LOGF_TRACE("run middleman loop");
+void middleman_loop(middleman_impl* impl, middleman_loop_data* loop) {
+    t_loop = loop;
+    middleman_event_handler* handler = loop->handler.get();
+    CPPA_LOGF_TRACE("run middleman loop " << loop->id);
     CPPA_LOGF_INFO("middleman runs at "
                    << to_string(impl->node()));
     handler->init();
-    impl->continue_reader(new middleman_overseer(impl->m_pipe_out,
-                                                 impl->m_queue));
+    impl->continue_reader(new middleman_overseer(loop->wakeup_out,
+                                                 loop->queue));
     handler->update();
-    while (!impl->done()) {
+    while (!loop->done) {
         handler->poll([&](event_bitmask mask, continuable* io) {
             switch (mask) {
                 default: CPPA_CRITICAL("invalid event");
@@ -513,6 +814,12 @@ namespace {
 
 std::atomic<size_t> default_max_msg_size{16 * 1024 * 1024};
 
+std::atomic<size_t> default_middleman_threads{1};
+
+std::atomic<size_t> default_compression_threshold{0};
+
+std::atomic<size_t> default_remote_connections{1};
+
 } // namespace <anonymous>
 
 void max_msg_size(size_t size)
@@ -525,4 +832,49 @@ size_t max_msg_size()
   return default_max_msg_size;
 }
 
+void middleman_threads(size_t num_threads) {
+    default_middleman_threads = std::max<size_t>(num_threads, 1);
+}
+
+size_t middleman_threads() {
+    return default_middleman_threads;
+}
+
+void compression_threshold(size_t num_bytes) {
+    default_compression_threshold = num_bytes;
+}
+
+size_t compression_threshold() {
+    return default_compression_threshold;
+}
+
+void remote_connections(size_t num) {
+    default_remote_connections = std::min(std::max<size_t>(num, 1),
+                                          io::message_lanes::max_lanes);
+}
+
+size_t remote_connections() {
+    return default_remote_connections;
+}
+
+void remote_watermarks(size_t low, size_t high, io::overflow_policy policy) {
+    std::lock_guard<std::mutex> guard{io::s_flow_control_mtx};
+    io::s_low_watermark = std::min(low, high);
+    io::s_high_watermark = high;
+    io::s_overflow_policy = policy;
+}
+
+void notify_on_capacity(const actor_addr& whom, const actor_addr& listener) {
+    auto msg = make_any_tuple(atom("CAPACITY"), whom);
+    auto mm = get_middleman();
+    if (!whom || whom.node() == *mm->node()) {
+        // local actors are always reachable
+        auto ptr = detail::raw_access::get(listener);
+        if (ptr) ptr->enqueue({invalid_actor_addr, ptr}, std::move(msg));
+        return;
+    }
+    mm->outbound_queue(whom.node())->notify_on_capacity(listener,
+                                                        std::move(msg));
+}
+
 } // namespace cppa
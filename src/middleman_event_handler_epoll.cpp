@@ -114,18 +114,21 @@ class middleman_event_handler_impl : public middleman_event_handler {
         int operation;
         epoll_event ee;
         ee.data.ptr = ptr;
+        // we are using edge-triggered mode, i.e., each continuable
+        // has to read (write) until its socket would block
         switch (new_bitmask) {
             case event::none:
                 CPPA_REQUIRE(me == fd_meta_event::erase);
                 ee.events = 0;
                 break;
             case event::read:
-                ee.events = EPOLLIN | EPOLLRDHUP;
+                ee.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
                 break;
             case event::write:
-                ee.events = EPOLLOUT;
+                ee.events = EPOLLOUT | EPOLLET;
+                break;
             case event::both:
-                ee.events = EPOLLIN | EPOLLRDHUP | EPOLLOUT;
+                ee.events = EPOLLIN | EPOLLRDHUP | EPOLLOUT | EPOLLET;
                 break;
             default: CPPA_CRITICAL("invalid event bitmask");
         }
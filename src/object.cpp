@@ -73,7 +73,7 @@ object::object(const object& other) {
                                          : m_type->new_instance(other.m_value);
 }
 
-object::object(object&& other) : m_value(&s_unit), m_type(unit_type()) {
+object::object(object&& other) noexcept : m_value(&s_unit), m_type(unit_type()) {
     swap(other);
 }
 
@@ -42,6 +42,10 @@ void object_array::push_back(object&& what) {
     m_elements.push_back(std::move(what));
 }
 
+void object_array::reserve(size_t num_elements) {
+    m_elements.reserve(num_elements);
+}
+
 void* object_array::mutable_at(size_t pos) {
     return m_elements[pos].mutable_value();
 }
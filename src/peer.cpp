@@ -41,9 +41,9 @@
 #include "cppa/exit_reason.hpp"
 #include "cppa/actor_proxy.hpp"
 #include "cppa/message_header.hpp"
-#include "cppa/binary_serializer.hpp"
 #include "cppa/binary_deserializer.hpp"
 
+#include "cppa/util/lz4.hpp"
 #include "cppa/util/algorithm.hpp"
 
 #include "cppa/detail/demangle.hpp"
@@ -59,19 +59,51 @@ using namespace std;
 
 namespace cppa { namespace io {
 
+namespace {
+
+// number of bytes read from the socket at once; several
+// messages are framed and deserialized per read operation
+constexpr size_t receive_buffer_size = 64 * 1024;
+
+// optional features announced via PROTOCOL messages
+constexpr std::uint32_t compression_feature = 0x01;
+constexpr std::uint32_t pooling_feature = 0x02;
+
+// returns true if @p msg is handled by the peer itself
+bool is_system_message(const any_tuple& msg) {
+    if (msg.empty() || msg.type_at(0) != uniform_typeid<atom_value>()) {
+        return false;
+    }
+    switch (msg.get_as<atom_value>(0)) {
+        case atom("MONITOR"):
+        case atom("KILL_PROXY"):
+        case atom("LINK"):
+        case atom("UNLINK"):
+        case atom("ADD_TYPE"):
+        case atom("PROTOCOL"):
+        case atom("LANES"):
+            return true;
+        default:
+            return false;
+    }
+}
+
+} // namespace <anonymous>
+
 peer::peer(middleman* parent,
            const input_stream_ptr& in,
            const output_stream_ptr& out,
-           node_id_ptr peer_ptr)
+           node_id_ptr peer_ptr,
+           size_t lane)
 : super(parent, out, in->read_handle(), out->write_handle())
 , m_in(in), m_state((peer_ptr) ? wait_for_msg_size : wait_for_process_info)
-, m_node(peer_ptr) {
-    m_rd_buf.final_size( m_state == wait_for_process_info
-                       ? sizeof(uint32_t) + node_id::host_id_size
-                       : sizeof(uint32_t));
+, m_node(peer_ptr), m_rd_pos(0), m_msg_size(0)
+, m_msg_format(wire_format::v1), m_msg_compressed(false), m_lane(lane) {
+    m_rd_buf.final_size(receive_buffer_size);
     // state == wait_for_msg_size iff peer was created using remote_peer()
-    // in this case, this peer must be erased if no proxy of it remains
-    m_stop_on_last_proxy_exited = m_state == wait_for_msg_size;
+    // in this case, this peer must be erased if no proxy of it remains;
+    // additional lanes are closed along with lane 0
+    m_stop_on_last_proxy_exited = m_state == wait_for_msg_size && lane == 0;
     m_meta_hdr = uniform_typeid<message_header>();
     m_meta_msg = uniform_typeid<any_tuple>();
 }
@@ -80,9 +112,9 @@ void peer::io_failed(event_bitmask mask) {
     CPPA_LOG_TRACE("node = " << (m_node ? to_string(*m_node) : "nullptr")
                    << " mask = " << mask);
     // make sure this code is executed only once by filtering for read failure
-    if (mask == event::read && m_node) {
+    if (mask == event::read && m_node && connected_lane()) {
         // kill all proxies
-        auto& children = parent()->get_namespace().proxies(*m_node);
+        auto children = parent()->get_namespace().proxies(*m_node);
         for (auto& kvp : children) {
             auto ptr = kvp.second.promote();
             if (ptr) {
@@ -96,21 +128,59 @@ void peer::io_failed(event_bitmask mask) {
 
 continue_reading_result peer::continue_reading() {
     CPPA_LOG_TRACE("");
+    // read until the socket would block, because a short read does not
+    // imply that the connection has not been closed in the meantime
     for (;;) {
+        auto before = m_rd_buf.size();
         try { m_rd_buf.append_from(m_in.get()); }
         catch (exception&) {
             return read_failure;
         }
-        if (!m_rd_buf.full()) return read_continue_later; // try again later
+        auto num_bytes = m_rd_buf.size() - before;
+        if (num_bytes == 0) return read_continue_later;
+        // frame and handle all complete messages in the buffer
+        auto result = handle_received_data();
+        if (result != read_continue_later) return result;
+        // keep only the incomplete tail of the buffer, if any
+        m_rd_buf.erase_leading(m_rd_pos);
+        m_rd_pos = 0;
+        auto needed = (m_state == read_message) ? m_msg_size : sizeof(uint32_t);
+        if (m_rd_buf.size() + m_rd_buf.remaining() < needed) {
+            m_rd_buf.acquire(needed - m_rd_buf.size());
+        }
+    }
+}
+
+continue_reading_result peer::handle_received_data() {
+    for (;;) {
+        auto available = m_rd_buf.size() - m_rd_pos;
+        auto data = m_rd_buf.offset_data(m_rd_pos);
         switch (m_state) {
             case wait_for_process_info: {
-                //DEBUG("peer_connection::continue_reading: "
-                //      "wait_for_process_info");
+                auto needed = sizeof(uint32_t) + node_id::host_id_size;
+                if (available < sizeof(uint32_t)) return read_continue_later;
                 uint32_t process_id;
+                memcpy(&process_id, data, sizeof(uint32_t));
+                // connections for additional lanes prefix the
+                // process info with a marker and append the lane
+                bool is_lane = process_id == message_lanes::handshake_marker;
+                if (is_lane) needed += 2 * sizeof(uint32_t);
+                if (available < needed) return read_continue_later;
+                auto pos = data;
+                if (is_lane) {
+                    pos += sizeof(uint32_t);
+                    memcpy(&process_id, pos, sizeof(uint32_t));
+                }
                 node_id::host_id_type host_id;
-                memcpy(&process_id, m_rd_buf.data(), sizeof(uint32_t));
-                memcpy(host_id.data(), m_rd_buf.offset_data(sizeof(uint32_t)),
+                memcpy(host_id.data(), pos + sizeof(uint32_t),
                        node_id::host_id_size);
+                if (is_lane) {
+                    uint32_t lane;
+                    memcpy(&lane, pos + sizeof(uint32_t) + node_id::host_id_size,
+                           sizeof(uint32_t));
+                    m_lane = lane;
+                }
+                m_rd_pos += needed;
                 m_node.reset(new node_id(process_id, host_id));
                 if (*parent()->node() == *m_node) {
                     std::cerr << "*** middleman warning: "
@@ -120,31 +190,56 @@ continue_reading_result peer::continue_reading() {
                 }
                 CPPA_LOG_DEBUG("read process info: " << to_string(*m_node));
                 if (!parent()->register_peer(*m_node, this)) {
-                    CPPA_LOG_ERROR("multiple incoming connections "
-                                   "from the same node");
+                    CPPA_LOG_ERROR_IF(m_lane == 0,
+                                      "multiple incoming connections "
+                                      "from the same node");
+                    CPPA_LOG_INFO_IF(m_lane != 0,
+                                     "refused connection for lane " << m_lane);
                     return read_failure;
                 }
                 // initialization done
                 m_state = wait_for_msg_size;
-                m_rd_buf.clear();
-                m_rd_buf.final_size(sizeof(uint32_t));
                 break;
             }
             case wait_for_msg_size: {
-                //DEBUG("peer_connection::continue_reading: wait_for_msg_size");
+                if (available < sizeof(uint32_t)) return read_continue_later;
                 uint32_t msg_size;
-                memcpy(&msg_size, m_rd_buf.data(), sizeof(uint32_t));
-                m_rd_buf.clear();
-                m_rd_buf.final_size(msg_size);
+                memcpy(&msg_size, data, sizeof(uint32_t));
+                m_rd_pos += sizeof(uint32_t);
+                if (msg_size & default_message_queue::v2_flag) {
+                    m_msg_format = wire_format::v2;
+                    msg_size &= ~default_message_queue::v2_flag;
+                }
+                else m_msg_format = wire_format::v1;
+                m_msg_compressed = (msg_size & default_message_queue::compressed_flag) != 0;
+                msg_size &= ~default_message_queue::compressed_flag;
+                if (msg_size > m_rd_buf.maximum_size()) {
+                    CPPA_LOG_ERROR("incoming message exceeds maximum size: "
+                                   << msg_size);
+                    return read_failure;
+                }
+                m_msg_size = msg_size;
                 m_state = read_message;
                 break;
             }
             case read_message: {
-                //DEBUG("peer_connection::continue_reading: read_message");
+                if (available < m_msg_size) return read_continue_later;
                 message_header hdr;
                 any_tuple msg;
-                binary_deserializer bd(m_rd_buf.data(), m_rd_buf.size(),
-                                       &(parent()->get_namespace()), &m_incoming_types);
+                // deserialize in place from the receive buffer
+                // unless the message needs to be decompressed first
+                size_t size = m_msg_size;
+                if (m_msg_compressed) {
+                    if (!decompress(data, size)) {
+                        CPPA_LOG_ERROR("received malformed compressed message");
+                        return read_failure;
+                    }
+                    data = m_decompressed.data();
+                    size = m_decompressed.size();
+                }
+                binary_deserializer bd(data, size,
+                                       &(parent()->get_namespace()),
+                                       &m_incoming_types, m_msg_format);
                 try {
                     m_meta_hdr->deserialize(&hdr, &bd);
                     m_meta_msg->deserialize(&msg, &bd);
@@ -155,7 +250,16 @@ continue_reading_result peer::continue_reading() {
                                    << ", what(): " << e.what());
                     return read_failure;
                 }
+                m_rd_pos += m_msg_size;
+                m_state = wait_for_msg_size;
                 CPPA_LOG_DEBUG("deserialized: " << to_string(hdr) << " " << to_string(msg));
+                // forward user messages without pattern matching, because
+                // match() would hold a second reference to msg and thus
+                // cause a copy of the tuple when invoking a handler
+                if (!is_system_message(msg)) {
+                    deliver(hdr, move(msg));
+                    break;
+                }
                 match(msg) (
                     // monitor messages are sent automatically whenever
                     // actor_proxy_cache creates a new proxy
@@ -177,20 +281,34 @@ continue_reading_result peer::continue_reading() {
                         auto uti = imap->by_uniform_name(name);
                         m_incoming_types.emplace(id, uti);
                     },
+                    on(atom("PROTOCOL"), arg_match) >> [&](std::uint32_t version,
+                                                           std::uint32_t features) {
+                        // the remote node understands the compact format
+                        if (version >= static_cast<std::uint32_t>(wire_format::v2)) {
+                            queue().use_wire_format(wire_format::v2);
+                        }
+                        if (features & compression_feature) {
+                            queue().enable_compression();
+                        }
+                        // nodes without connection pooling
+                        // never send a LANES message
+                        if (m_lane == 0 && !(features & pooling_feature)) {
+                            parent()->accept_lanes(*m_node, 0x01);
+                        }
+                    },
+                    on(atom("LANES"), arg_match) >> [&](std::uint32_t mask) {
+                        if (m_lane == 0) parent()->accept_lanes(*m_node, mask);
+                    },
                     others() >> [&] {
                         deliver(hdr, move(msg));
                     }
                 );
-                m_rd_buf.clear();
-                m_rd_buf.final_size(sizeof(uint32_t));
-                m_state = wait_for_msg_size;
                 break;
             }
             default: {
                 CPPA_CRITICAL("illegal state");
             }
         }
-        // try to read more (next iteration)
     }
 }
 
@@ -227,7 +345,7 @@ void peer::monitor(const actor_addr&,
         CPPA_LOG_DEBUG("attach functor to " << entry.first.get());
         auto mm = parent();
         entry.first->attach_functor([=](uint32_t reason) {
-            mm->run_later([=] {
+            mm->run_later(*node, [=] {
                 CPPA_LOGC_TRACE("cppa::io::peer",
                                 "monitor$kill_proxy_helper",
                                 "reason = " << reason);
@@ -338,11 +456,8 @@ void peer::unlink(const actor_addr& lhs, const actor_addr& rhs) {
 continue_writing_result peer::continue_writing() {
     CPPA_LOG_TRACE("");
     auto result = super::continue_writing();
-    while (result == write_done && !queue().empty()) {
-        auto tmp = queue().pop();
-        enqueue(tmp.first, tmp.second);
-        result = super::continue_writing();
-    }
+    // the queue is set once the remote node is known
+    if (m_queue) m_queue->unwritten_bytes(unwritten_bytes());
     if (result == write_done && stop_on_last_proxy_exited() && !has_unwritten_data()) {
         if (parent()->get_namespace().count_proxies(*m_node) == 0) {
             parent()->last_proxy_exited(this);
@@ -351,47 +466,54 @@ continue_writing_result peer::continue_writing() {
     return result;
 }
 
-void peer::add_type_if_needed(const std::string& tname) {
-    if (m_outgoing_types.id_of(tname) == 0) {
-        auto id = m_outgoing_types.max_id() + 1;
-        auto imap = get_uniform_type_info_map();
-        auto uti = imap->by_uniform_name(tname);
-        m_outgoing_types.emplace(id, uti);
-        enqueue_impl({invalid_actor_addr, nullptr}, make_any_tuple(atom("ADD_TYPE"), id, tname));
+void peer::enqueue(const message_header& hdr, const any_tuple& msg) {
+    queue().enqueue(hdr, msg);
+    flush_queue();
+}
+
+void peer::announce_protocol() {
+    enqueue(make_any_tuple(atom("PROTOCOL"),
+                           static_cast<std::uint32_t>(wire_format::v2),
+                           compression_feature | pooling_feature));
+}
+
+bool peer::decompress(const void* data, size_t size) {
+    std::uint32_t original_size;
+    if (size < sizeof(std::uint32_t)) return false;
+    memcpy(&original_size, data, sizeof(std::uint32_t));
+    if (original_size > m_rd_buf.maximum_size()) {
+        CPPA_LOG_ERROR("decompressed message too big");
+        return false;
     }
+    m_decompressed.resize(original_size);
+    return util::lz4_decompress(static_cast<const char*>(data)
+                                + sizeof(std::uint32_t),
+                                size - sizeof(std::uint32_t),
+                                m_decompressed.data(), original_size);
 }
 
-void peer::enqueue_impl(const message_header& hdr, const any_tuple& msg) {
+void peer::flush_queue() {
+    flush_queue(queue());
+}
+
+void peer::flush_queue(default_message_queue& q) {
     CPPA_LOG_TRACE("");
-    auto tname = msg.tuple_type_names();
-    add_type_if_needed((tname) ? *tname : detail::get_tuple_type_names(*msg.vals()));
-    uint32_t size = 0;
-    auto& wbuf = write_buffer();
-    auto before = wbuf.size();
-    binary_serializer bs(&wbuf, &(parent()->get_namespace()), &m_outgoing_types);
-    wbuf.write(sizeof(uint32_t), &size);
-    try { bs << hdr << msg; }
-    catch (exception& e) {
-        CPPA_LOG_ERROR(to_verbose_string(e));
-        cerr << "*** exception in peer::enqueue; "
-             << to_verbose_string(e)
-             << endl;
-        return;
-    }
-    CPPA_LOG_DEBUG("serialized: " << to_string(hdr) << " " << to_string(msg));
-    size = (wbuf.size() - before) - sizeof(std::uint32_t);
-    // update size in buffer
-    memcpy(wbuf.offset_data(before), &size, sizeof(std::uint32_t));
+    auto num = q.drain([&](util::buffer& buf) {
+        write(std::move(buf));
+    });
+    q.unwritten_bytes(unwritten_bytes());
+    CPPA_LOG_DEBUG_IF(num > 0, num << " segments moved to output buffer");
+    static_cast<void>(num); // keep compiler happy
 }
 
-void peer::enqueue(const message_header& hdr, const any_tuple& msg) {
-    enqueue_impl(hdr, msg);
-    register_for_writing();
+bool peer::connected_lane() const {
+    return m_lane == 0
+           || (m_lanes && m_lanes->state(m_lane) == message_lanes::active);
 }
 
 void peer::dispose() {
     CPPA_LOG_TRACE(CPPA_ARG(this));
-    parent()->get_namespace().erase(*m_node);
+    if (m_lane == 0) parent()->get_namespace().erase(*m_node);
     parent()->del_peer(this);
     delete this;
 }
@@ -58,6 +58,7 @@ remote_actor_proxy::remote_actor_proxy(actor_id mid,
         : super(mid), m_parent(parent) {
     CPPA_REQUIRE(parent != nullptr);
     CPPA_LOG_INFO(CPPA_ARG(mid) << ", " << CPPA_TARG(*pinfo, to_string));
+    m_lanes = parent->outbound_lanes(*pinfo);
     m_node = std::move(pinfo);
 }
 
@@ -67,7 +68,7 @@ remote_actor_proxy::~remote_actor_proxy() {
     auto mm = m_parent;
     CPPA_LOG_INFO(CPPA_ARG(m_id) << ", " << CPPA_TSARG(*m_node)
                    << ", protocol = " << detail::demangle(typeid(*m_parent)));
-    mm->run_later([aid, node, mm] {
+    mm->run_later(*node, [aid, node, mm] {
         CPPA_LOGC_TRACE("cppa::io::remote_actor_proxy",
                         "~remote_actor_proxy$run_later",
                         "node = " << to_string(*node) << ", aid " << aid);
@@ -120,14 +121,12 @@ void remote_actor_proxy::forward_msg(const message_header& hdr, any_tuple msg) {
             default: break;
         }
     }
-    auto node = m_node;
-    auto mm = m_parent;
-    m_parent->run_later([hdr, msg, node, mm] {
-        CPPA_LOGC_TRACE("cppa::io::remote_actor_proxy",
-                        "forward_msg$forwarder",
-                        "");
-        mm->deliver(*node, hdr, msg);
-    });
+    // the message is serialized on the calling thread and the middleman
+    // only needs to be notified if the queue was empty
+    auto lane = m_lanes->select(hdr, m_id);
+    if (m_lanes->queue(lane)->enqueue(hdr, msg)) {
+        m_parent->flush_later(m_node, lane);
+    }
 }
 
 void remote_actor_proxy::enqueue(const message_header& hdr, any_tuple msg) {
@@ -141,7 +140,7 @@ void remote_actor_proxy::enqueue(const message_header& hdr, any_tuple msg) {
         CPPA_LOG_DEBUG("received KILL_PROXY message");
         intrusive_ptr<remote_actor_proxy> _this{this};
         auto reason = msg.get_as<uint32_t>(1);
-        m_parent->run_later([_this, reason] {
+        m_parent->run_later(*m_node, [_this, reason] {
             CPPA_LOGC_TRACE("cppa::io::remote_actor_proxy",
                             "enqueue$kill_proxy_helper",
                             "KILL_PROXY " << to_string(_this->address())
@@ -153,7 +152,22 @@ void remote_actor_proxy::enqueue(const message_header& hdr, any_tuple msg) {
             });
         });
     }
-    else forward_msg(hdr, move(msg));
+    else if (m_lanes->queue(m_lanes->select(hdr, m_id))->admit(hdr)) {
+        forward_msg(hdr, move(msg));
+    }
+    else if (hdr.sender && hdr.id.is_request()) {
+        // the outbound queue is overloaded
+        m_parent->run_later([hdr] {
+            CPPA_LOGC_TRACE("cppa::io::remote_actor_proxy",
+                            "enqueue$bouncer",
+                            "bounce message, remote node overloaded");
+            detail::sync_request_bouncer f{exit_reason::remote_overloaded};
+            f(hdr.sender, hdr.id);
+        });
+    }
+    else {
+        CPPA_LOG_DEBUG("dropped message, remote node overloaded");
+    }
 }
 
 void remote_actor_proxy::link_to(const actor_addr& other) {
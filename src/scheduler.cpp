@@ -28,10 +28,14 @@
 \******************************************************************************/
 
 
+#include <limits>
+#include <algorithm>
 #include <thread>
 #include <atomic>
+#include <vector>
 #include <chrono>
 #include <iostream>
+#include <unordered_map>
 
 #include "cppa/on.hpp"
 #include "cppa/policy.hpp"
@@ -45,8 +49,10 @@
 
 #include "cppa/detail/proper_actor.hpp"
 #include "cppa/detail/actor_registry.hpp"
+#include "cppa/detail/timing_wheel.hpp"
 #include "cppa/detail/singleton_manager.hpp"
 #include "cppa/detail/thread_pool_scheduler.hpp"
+#include "cppa/detail/work_stealing_scheduler.hpp"
 
 using std::move;
 
@@ -58,6 +64,10 @@ typedef std::chrono::high_resolution_clock hrc;
 
 typedef hrc::time_point time_point;
 
+std::atomic<size_t> s_max_throughput{std::numeric_limits<size_t>::max()};
+
+std::atomic<timer_resolution> s_timer_resolution{timer_resolution::fine};
+
 typedef policy::policies<policy::no_scheduling, policy::not_prioritizing,
                          policy::no_resume, policy::nestable_invoke>
         timer_actor_policies;
@@ -67,8 +77,9 @@ class delayed_msg {
  public:
 
     delayed_msg(message_header&& arg1,
-                any_tuple&&      arg2)
-    : hdr(move(arg1)), msg(move(arg2)) { }
+                any_tuple&&      arg2,
+                std::uint64_t    arg3 = 0)
+    : hdr(move(arg1)), msg(move(arg2)), token(arg3) { }
 
     delayed_msg(delayed_msg&&) = default;
     delayed_msg(const delayed_msg&) = default;
@@ -79,27 +90,26 @@ class delayed_msg {
         hdr.deliver(std::move(msg));
     }
 
+    // a non-zero token allows the sender to cancel this message
+    inline std::uint64_t cancel_token() const {
+        return token;
+    }
+
  private:
 
     message_header hdr;
     any_tuple      msg;
+    std::uint64_t  token;
 
 };
 
-template<class Map>
-inline void insert_dmsg(Map& storage, const util::duration& d,
-                        message_header&& hdr, any_tuple&& tup) {
-    auto tout = hrc::now();
-    tout += d;
-    delayed_msg dmsg{move(hdr), move(tup)};
-    storage.insert(std::make_pair(std::move(tout), std::move(dmsg)));
-}
-
 class timer_actor final : public detail::proper_actor<blocking_actor,
                                                       timer_actor_policies> {
 
  public:
 
+    timer_actor(hrc::duration resolution) : m_resolution(resolution) { }
+
     inline unique_mailbox_element_pointer dequeue() {
         await_data();
         return next_message();
@@ -116,14 +126,36 @@ class timer_actor final : public detail::proper_actor<blocking_actor,
         // setup & local variables
         bool done = false;
         unique_mailbox_element_pointer msg_ptr;
-        auto tout = hrc::now();
-        std::multimap<decltype(tout), delayed_msg> messages;
+        typedef detail::timing_wheel<delayed_msg> wheel_type;
+        wheel_type messages{m_resolution};
+        // maps cancel tokens to pending messages
+        std::unordered_map<std::uint64_t, wheel_type::entry*> cancellable;
         // message handling rules
         auto mfun = (
             on(atom("SEND"), arg_match) >> [&](const util::duration& d,
                                                message_header& hdr,
                                                any_tuple& tup) {
-                insert_dmsg(messages, d, move(hdr), move(tup));
+                auto tout = hrc::now();
+                tout += d;
+                messages.add(tout, delayed_msg{move(hdr), move(tup)});
+            },
+            on(atom("SEND"), arg_match) >> [&](const util::duration& d,
+                                               message_header& hdr,
+                                               any_tuple& tup,
+                                               std::uint64_t token) {
+                auto tout = hrc::now();
+                tout += d;
+                auto e = messages.add(tout,
+                                      delayed_msg{move(hdr), move(tup), token});
+                cancellable.emplace(token, e);
+            },
+            on(atom("CANCEL"), arg_match) >> [&](std::uint64_t token) {
+                // the message might have been delivered already
+                auto i = cancellable.find(token);
+                if (i != cancellable.end()) {
+                    messages.cancel(i->second);
+                    cancellable.erase(i);
+                }
             },
             on(atom("DIE")) >> [&] {
                 done = true;
@@ -141,17 +173,15 @@ class timer_actor final : public detail::proper_actor<blocking_actor,
             while (!msg_ptr) {
                 if (messages.empty()) msg_ptr = dequeue();
                 else {
-                    tout = hrc::now();
                     // handle timeouts (send messages)
-                    auto it = messages.begin();
-                    while (it != messages.end() && (it->first) <= tout) {
-                        it->second.eval();
-                        messages.erase(it);
-                        it = messages.begin();
-                    }
+                    messages.advance(hrc::now(), [&](delayed_msg& dmsg) {
+                        auto token = dmsg.cancel_token();
+                        if (token != 0) cancellable.erase(token);
+                        dmsg.eval();
+                    });
                     // wait for next message or next timeout
-                    if (it != messages.end()) {
-                        msg_ptr = try_dequeue(it->first);
+                    if (!messages.empty()) {
+                        msg_ptr = try_dequeue(messages.next_timeout());
                     }
                 }
             }
@@ -160,6 +190,10 @@ class timer_actor final : public detail::proper_actor<blocking_actor,
         }
     }
 
+ private:
+
+    hrc::duration m_resolution;
+
 };
 
 } // namespace <anonymous>
@@ -168,24 +202,40 @@ class scheduler_helper {
 
  public:
 
-    scheduler_helper() : m_timer(new timer_actor), m_printer(true) { }
+    scheduler_helper() : m_next_token(0), m_printer(true) { }
 
-    void start() {
+    void start(size_t num_timers) {
+        auto res = std::chrono::milliseconds(1);
+        if (s_timer_resolution == timer_resolution::coarse) {
+            res = std::chrono::milliseconds(10);
+        }
         // launch threads
-        m_timer_thread = std::thread{&scheduler_helper::timer_loop, m_timer.get()};
+        for (size_t i = 0; i < std::max<size_t>(num_timers, 1); ++i) {
+            m_timers.emplace_back(new timer_actor(res));
+            m_timer_threads.emplace_back(&scheduler_helper::timer_loop,
+                                         m_timers.back().get());
+        }
         m_printer_thread = std::thread{&scheduler_helper::printer_loop, m_printer.get()};
     }
 
     void stop() {
         auto msg = make_any_tuple(atom("DIE"));
-        m_timer->enqueue({invalid_actor_addr, nullptr}, msg);
+        for (auto& t : m_timers) t->enqueue({invalid_actor_addr, nullptr}, msg);
         m_printer->enqueue({invalid_actor_addr, nullptr}, msg);
-        m_timer_thread.join();
+        for (auto& t : m_timer_threads) t.join();
         m_printer_thread.join();
     }
 
-    intrusive_ptr<timer_actor> m_timer;
-    std::thread m_timer_thread;
+    // messages of the same sender always use the same timer,
+    // i.e., delayed messages with equal timeouts arrive in order
+    inline timer_actor* timer_for(const actor_addr& sender) {
+        if (m_timers.size() == 1 || !sender) return m_timers.front().get();
+        return m_timers[sender.id() % m_timers.size()].get();
+    }
+
+    std::vector<intrusive_ptr<timer_actor>> m_timers;
+    std::vector<std::thread> m_timer_threads;
+    std::atomic<std::uint64_t> m_next_token;
 
     scoped_actor m_printer;
     std::thread m_printer_thread;
@@ -261,7 +311,7 @@ scheduler::scheduler() : m_helper(nullptr) { }
 
 void scheduler::initialize() {
     m_helper = new scheduler_helper;
-    m_helper->start();
+    m_helper->start(num_timers());
 }
 
 void scheduler::destroy() {
@@ -274,8 +324,29 @@ scheduler::~scheduler() {
     delete m_helper;
 }
 
-actor scheduler::delayed_send_helper() {
-    return m_helper->m_timer.get();
+size_t scheduler::num_timers() const {
+    return 1;
+}
+
+actor scheduler::delayed_send_helper(const actor_addr& sender) {
+    return m_helper->timer_for(sender);
+}
+
+std::uint64_t scheduler::cancellable_delayed_send(message_header hdr,
+                                                  const util::duration& rtime,
+                                                  any_tuple data) {
+    auto token = ++m_helper->m_next_token;
+    auto helper = delayed_send_helper(hdr.sender);
+    auto tup = make_any_tuple(atom("SEND"), rtime, std::move(hdr),
+                              std::move(data), token);
+    helper->enqueue(message_header{}, std::move(tup));
+    return token;
+}
+
+void scheduler::cancel_delayed_send(const actor_addr& sender,
+                                    std::uint64_t token) {
+    delayed_send_helper(sender)->enqueue(message_header{},
+                                         make_any_tuple(atom("CANCEL"), token));
 }
 
 void set_scheduler(scheduler* sched) {
@@ -288,6 +359,23 @@ void set_default_scheduler(size_t num_threads) {
     set_scheduler(new detail::thread_pool_scheduler(num_threads));
 }
 
+void set_work_stealing_scheduler(size_t num_threads, bool pin_workers) {
+    set_scheduler(new detail::work_stealing_scheduler(num_threads,
+                                                      {}, pin_workers));
+}
+
+void set_max_throughput(size_t max_messages) {
+    s_max_throughput = std::max<size_t>(max_messages, 1);
+}
+
+size_t max_throughput() {
+    return s_max_throughput.load(std::memory_order_relaxed);
+}
+
+void set_timer_resolution(timer_resolution res) {
+    s_timer_resolution = res;
+}
+
 scheduler* scheduler::create_singleton() {
     return new detail::thread_pool_scheduler;
 }
@@ -57,9 +57,11 @@ struct thread_pool_scheduler::worker {
 
     job_queue* m_job_queue;
     job_ptr m_dummy;
+    idle_strategy* m_idle;
     std::thread m_thread;
 
-    worker(job_queue* jq, job_ptr dummy) : m_job_queue(jq), m_dummy(dummy) { }
+    worker(job_queue* jq, job_ptr dummy, idle_strategy* idle)
+    : m_job_queue(jq), m_dummy(dummy), m_idle(idle) { }
 
     void start() {
         m_thread = std::thread(&thread_pool_scheduler::worker_loop, this);
@@ -69,50 +71,34 @@ struct thread_pool_scheduler::worker {
 
     worker& operator=(const worker&) = delete;
 
-    bool aggressive(job_ptr& result) {
-        for (int i = 0; i < 100; ++i) {
-            result = m_job_queue->try_pop();
-            if (result) return true;
-            std::this_thread::yield();
-        }
-        return false;
-    }
-
-    bool moderate(job_ptr& result) {
-        for (int i = 0; i < 550; ++i) {
-            result =  m_job_queue->try_pop();
-            if (result) return true;
-            std::this_thread::sleep_for(std::chrono::microseconds(50));
-        }
-        return false;
-    }
-
-    bool relaxed(job_ptr& result) {
-        for (;;) {
-            result =  m_job_queue->try_pop();
-            if (result) return true;
-            std::this_thread::sleep_for(std::chrono::milliseconds(10));
-        }
-    }
-
     void operator()() {
         CPPA_LOG_TRACE("");
         detail::cs_thread fself;
         job_ptr job = nullptr;
         for (;;) {
-            aggressive(job) || moderate(job) || relaxed(job);
+            job = m_idle->await([&] { return m_job_queue->try_pop(); });
             CPPA_LOG_DEBUG("dequeued new job");
             if (job == m_dummy) {
                 CPPA_LOG_DEBUG("received dummy (quit)");
                 // dummy of doom received ...
                 m_job_queue->push_back(job); // kill the next guy
+                m_idle->notify();
                 return;                      // and say goodbye
             }
-            if (job->resume(&fself) == resumable::done) {
-                CPPA_LOG_DEBUG("actor is done");
-                /*FIXME bool hidden = job->is_hidden();
-                job->deref();
-                if (!hidden)*/ get_actor_registry()->dec_running();
+            switch (job->resume(&fself)) {
+                case resumable::done: {
+                    CPPA_LOG_DEBUG("actor is done");
+                    /*FIXME bool hidden = job->is_hidden();
+                    job->deref();
+                    if (!hidden)*/ get_actor_registry()->dec_running();
+                    break;
+                }
+                case resumable::reschedule: {
+                    // append to the tail to give other jobs a chance
+                    m_job_queue->push_back(job);
+                    break;
+                }
+                default: break;
             }
             job = nullptr;
         }
@@ -128,16 +114,18 @@ thread_pool_scheduler::thread_pool_scheduler() {
     m_num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 4);
 }
 
-thread_pool_scheduler::thread_pool_scheduler(size_t num_worker_threads) {
+thread_pool_scheduler::thread_pool_scheduler(size_t num_worker_threads,
+        const idle_strategy::settings& idle_settings) : m_idle(idle_settings) {
     m_num_threads = num_worker_threads;
 }
 
 void thread_pool_scheduler::supervisor_loop(job_queue* jqueue,
                                             resumable* dummy,
+                                            idle_strategy* idle,
                                             size_t num_threads) {
     std::vector<std::unique_ptr<thread_pool_scheduler::worker> > workers;
     for (size_t i = 0; i < num_threads; ++i) {
-        workers.emplace_back(new worker(jqueue, dummy));
+        workers.emplace_back(new worker(jqueue, dummy, idle));
         workers.back()->start();
     }
     // wait for workers
@@ -148,17 +136,18 @@ void thread_pool_scheduler::supervisor_loop(job_queue* jqueue,
 
 void thread_pool_scheduler::initialize() {
     m_supervisor = std::thread(&thread_pool_scheduler::supervisor_loop,
-                               &m_queue, &m_dummy, m_num_threads);
+                               &m_queue, &m_dummy, &m_idle, m_num_threads);
     super::initialize();
 }
 
 void thread_pool_scheduler::destroy() {
     CPPA_LOG_TRACE("");
     m_queue.push_back(&m_dummy);
+    m_idle.notify();
     CPPA_LOG_DEBUG("join supervisor");
     m_supervisor.join();
-    // make sure job queue is empty, because destructor of m_queue would
-    // otherwise delete elements it shouldn't
+    // make sure job queue is empty; each remaining job is
+    // a running actor that will never be resumed
     CPPA_LOG_DEBUG("flush queue");
     auto ptr = m_queue.try_pop();
     while (ptr != nullptr) {
@@ -173,8 +162,13 @@ void thread_pool_scheduler::destroy() {
     super::destroy();
 }
 
+size_t thread_pool_scheduler::num_timers() const {
+    return m_num_threads;
+}
+
 void thread_pool_scheduler::enqueue(resumable* what) {
     m_queue.push_back(what);
+    m_idle.notify();
 }
 
 } } // namespace cppa::detail
@@ -37,7 +37,7 @@
 
 namespace cppa {
 
-type_lookup_table::type_lookup_table() {
+type_lookup_table::type_lookup_table() : m_reserved(0) {
     auto uti_map = get_uniform_type_info_map();
     auto get = [=](const char* cstr) {
         return uti_map->by_uniform_name(cstr);
@@ -106,5 +106,13 @@ std::uint32_t type_lookup_table::max_id() const {
     return m_data.empty() ? 0 : m_data.back().first;
 }
 
+std::uint32_t type_lookup_table::next_id() const {
+    return std::max(max_id(), m_reserved) + 1;
+}
+
+void type_lookup_table::reserve_ids(std::uint32_t id) {
+    m_reserved = std::max(m_reserved, id);
+}
+
 
 } // namespace cppa
@@ -92,47 +92,31 @@ actor remote_actor(io::stream_ptr_pair conn) {
 
 actor remote_actor(const char* host, std::uint16_t port) {
     auto ptr = ipv4_io_stream::connect_to(host, port);
-    return remote_actor(stream_ptr_pair(ptr, ptr));
+    auto res = detail::remote_actor_impl(stream_ptr_pair(ptr, ptr),
+                                         string_set{}, host, port);
+    return detail::raw_access::unsafe_cast(res);
 }
 
 namespace detail {
 
-void publish_impl(abstract_actor_ptr ptr, std::unique_ptr<acceptor> aptr) {
-    // begin the scenes, we serialze/deserialize as actor
-    actor whom{raw_access::unsafe_cast(ptr.get())};
-    CPPA_LOGF_TRACE(CPPA_TARG(whom, to_string) << ", " << CPPA_MARG(aptr, get));
-    if (!whom) return;
-    get_actor_registry()->put(whom->id(), detail::raw_access::get(whom));
-    auto mm = get_middleman();
-    auto addr = whom.address();
-    auto sigs = whom->interface();
-    mm->register_acceptor(addr, new peer_acceptor(mm, move(aptr),
-                                                  addr, move(sigs)));
-}
+namespace {
 
-abstract_actor_ptr remote_actor_impl(stream_ptr_pair io, string_set expected) {
-    CPPA_LOGF_TRACE("io{" << io.first.get() << ", " << io.second.get() << "}");
-    auto mm = get_middleman();
-    auto pinf = mm->node();
-    std::uint32_t process_id = pinf->process_id();
-    // throws on error
-    io.second->write(&process_id, sizeof(std::uint32_t));
-    io.second->write(pinf->host_id().data(), pinf->host_id().size());
-    // deserialize: actor id, process id, node id, interface
-    actor_id remote_aid;
-    std::uint32_t peer_pid;
-    node_id::host_id_type peer_node_id;
+// deserialize handshake of peer_acceptor: actor id, process id,
+// node id, interface
+void read_handshake(input_stream& in,
+                    actor_id& remote_aid,
+                    std::uint32_t& peer_pid,
+                    node_id::host_id_type& peer_node_id,
+                    string_set& iface) {
     std::uint32_t iface_size;
-    std::set<std::string> iface;
-    auto& in = io.first;
     // -> actor id
-    in->read(&remote_aid, sizeof(actor_id));
+    in.read(&remote_aid, sizeof(actor_id));
     // -> process id
-    in->read(&peer_pid, sizeof(std::uint32_t));
+    in.read(&peer_pid, sizeof(std::uint32_t));
     // -> node id
-    in->read(peer_node_id.data(), peer_node_id.size());
+    in.read(peer_node_id.data(), peer_node_id.size());
     // -> interface
-    in->read(&iface_size, sizeof(std::uint32_t));
+    in.read(&iface_size, sizeof(std::uint32_t));
     if (iface_size > max_iface_size) {
         throw std::invalid_argument("Remote actor claims to have more than"
                                     +std::to_string(max_iface_size)+
@@ -142,7 +126,7 @@ abstract_actor_ptr remote_actor_impl(stream_ptr_pair io, string_set expected) {
     std::vector<char> strbuf;
     for (std::uint32_t i = 0; i < iface_size; ++i) {
         std::uint32_t str_size;
-        in->read(&str_size, sizeof(std::uint32_t));
+        in.read(&str_size, sizeof(std::uint32_t));
         if (str_size > max_iface_clause_size) {
             throw std::invalid_argument("Remote actor claims to have a"
                                         " reply_to<...>::with<...> clause with"
@@ -153,10 +137,90 @@ abstract_actor_ptr remote_actor_impl(stream_ptr_pair io, string_set expected) {
         }
         strbuf.reserve(str_size + 1);
         strbuf.resize(str_size);
-        in->read(strbuf.data(), str_size);
+        in.read(strbuf.data(), str_size);
         strbuf.push_back('\0');
         iface.insert(std::string{strbuf.data()});
     }
+}
+
+// opens the connections for all additional lanes of node and offers
+// all successfully connected lanes to node afterwards
+void connect_lanes(middleman* mm, const node_id_ptr& node,
+                   const char* host, std::uint16_t port) {
+    CPPA_LOGF_TRACE(CPPA_TARG(*node, to_string) << ", "
+                    << CPPA_ARG(host) << ", " << CPPA_ARG(port));
+    std::uint32_t offer = 0x01;
+    auto num_lanes = host ? mm->outbound_lanes(*node)->size() : 1;
+    auto pinf = mm->node();
+    for (std::uint32_t lane = 1; lane < num_lanes; ++lane) {
+        try {
+            auto ptr = ipv4_io_stream::connect_to(host, port);
+            auto marker = message_lanes::handshake_marker;
+            std::uint32_t process_id = pinf->process_id();
+            ptr->write(&marker, sizeof(std::uint32_t));
+            ptr->write(&process_id, sizeof(std::uint32_t));
+            ptr->write(pinf->host_id().data(), pinf->host_id().size());
+            ptr->write(&lane, sizeof(std::uint32_t));
+            actor_id aid;
+            std::uint32_t peer_pid;
+            node_id::host_id_type peer_node_id;
+            string_set iface;
+            read_handshake(*ptr, aid, peer_pid, peer_node_id, iface);
+            if (!(node_id{peer_pid, peer_node_id} == *node)) {
+                CPPA_LOGF_WARNING("lane " << lane << " connected to "
+                                  "a different node");
+                break;
+            }
+            stream_ptr_pair io{ptr, ptr};
+            mm->run_later(*node, [mm, io, node, lane] {
+                mm->new_peer(io.first, io.second, node, lane);
+            });
+            offer |= std::uint32_t{1} << lane;
+        }
+        catch (std::exception& e) {
+            CPPA_LOGF_WARNING("cannot connect lane " << lane << ": "
+                              << to_verbose_string(e));
+            static_cast<void>(e); // keep compiler happy
+            break;
+        }
+    }
+    mm->run_later(*node, [mm, node, offer] {
+        mm->offer_lanes(*node, offer);
+    });
+}
+
+} // namespace <anonymous>
+
+void publish_impl(abstract_actor_ptr ptr, std::unique_ptr<acceptor> aptr) {
+    // begin the scenes, we serialze/deserialize as actor
+    actor whom{raw_access::unsafe_cast(ptr.get())};
+    CPPA_LOGF_TRACE(CPPA_TARG(whom, to_string) << ", " << CPPA_MARG(aptr, get));
+    if (!whom) return;
+    get_actor_registry()->put(whom->id(), detail::raw_access::get(whom));
+    auto mm = get_middleman();
+    auto addr = whom.address();
+    auto sigs = whom->interface();
+    mm->register_acceptor(addr, new peer_acceptor(mm, move(aptr),
+                                                  addr, move(sigs)));
+}
+
+abstract_actor_ptr remote_actor_impl(stream_ptr_pair io,
+                                     string_set expected,
+                                     const char* host,
+                                     std::uint16_t port) {
+    CPPA_LOGF_TRACE("io{" << io.first.get() << ", " << io.second.get() << "}");
+    auto mm = get_middleman();
+    auto pinf = mm->node();
+    std::uint32_t process_id = pinf->process_id();
+    // throws on error
+    io.second->write(&process_id, sizeof(std::uint32_t));
+    io.second->write(pinf->host_id().data(), pinf->host_id().size());
+    // deserialize: actor id, process id, node id, interface
+    actor_id remote_aid;
+    std::uint32_t peer_pid;
+    node_id::host_id_type peer_node_id;
+    std::set<std::string> iface;
+    read_handshake(*io.first, remote_aid, peer_pid, peer_node_id, iface);
     // deserialization done, check interface
     if (iface != expected) {
         auto tostr = [](const std::set<std::string>& what) -> std::string {
@@ -197,19 +261,24 @@ abstract_actor_ptr remote_actor_impl(stream_ptr_pair io, string_set expected) {
         auto ptr = get_actor_registry()->get(remote_aid);
         return ptr;
     }
-    struct remote_actor_result { remote_actor_result* next; actor value; };
+    struct remote_actor_result {
+        remote_actor_result* next;
+        actor value;
+        bool connected; // true if a new connection has been established
+    };
     intrusive::blocking_single_reader_queue<remote_actor_result> q;
-    mm->run_later([mm, io, pinfptr, remote_aid, &q] {
+    mm->run_later(*pinfptr, [mm, io, pinfptr, remote_aid, &q] {
         CPPA_LOGC_TRACE("cppa",
                         "remote_actor$create_connection", "");
         auto pp = mm->get_peer(*pinfptr);
         CPPA_LOGF_INFO_IF(pp, "connection already exists (re-use old one)");
         if (!pp) mm->new_peer(io.first, io.second, pinfptr);
         auto res = mm->get_namespace().get_or_put(pinfptr, remote_aid);
-        q.push_back(new remote_actor_result{0, res});
+        q.push_back(new remote_actor_result{0, res, pp == nullptr});
     });
     std::unique_ptr<remote_actor_result> result(q.pop());
     CPPA_LOGF_DEBUG(CPPA_MARG(result, get));
+    if (result->connected) connect_lanes(mm, pinfptr, host, port);
     return raw_access::get(result->value);
 }
 
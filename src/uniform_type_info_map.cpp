@@ -663,6 +663,7 @@ class default_meta_tuple : public uniform_type_info {
         if (instance) result = new object_array{*cast(instance)};
         else {
             result = new object_array;
+            result->reserve(m_elements.size());
             for (auto uti : m_elements) result->push_back(uti->create());
         }
         result->ref();
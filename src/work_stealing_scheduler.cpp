@@ -0,0 +1,309 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <mutex>
+#include <deque>
+#include <random>
+#include <thread>
+#include <cstddef>
+#include <stdexcept>
+
+#include "cppa/logging.hpp"
+
+#include "cppa/util/shared_spinlock.hpp"
+
+#include "cppa/detail/cs_thread.hpp"
+#include "cppa/detail/actor_registry.hpp"
+#include "cppa/detail/work_stealing_scheduler.hpp"
+
+namespace cppa { namespace detail {
+
+resumable::resume_result work_stealing_scheduler::dummy::resume(detail::cs_thread*) {
+    throw std::logic_error("work_stealing_scheduler::dummy::resume");
+}
+
+class work_stealing_scheduler::worker {
+
+    typedef std::lock_guard<util::shared_spinlock> guard_type;
+
+ public:
+
+    typedef resumable* job_ptr;
+
+    worker(work_stealing_scheduler* parent, size_t id, size_t node, int cpu)
+    : m_parent(parent), m_id(id), m_node(node), m_cpu(cpu)
+    , m_rng(static_cast<unsigned>(id)) { }
+
+    worker(const worker&) = delete;
+
+    worker& operator=(const worker&) = delete;
+
+    void start() {
+        m_thread = std::thread(&work_stealing_scheduler::worker_loop, this);
+    }
+
+    void join() {
+        m_thread.join();
+    }
+
+    inline work_stealing_scheduler* parent() const {
+        return m_parent;
+    }
+
+    inline size_t node() const {
+        return m_node;
+    }
+
+    // sets the victims for stealing on the same node and on other nodes
+    void set_victims(std::vector<worker*> near, std::vector<worker*> far) {
+        m_near = std::move(near);
+        m_far = std::move(far);
+    }
+
+    // called only by the thread owning this worker
+    void push_local(job_ptr job) {
+        guard_type guard(m_lock);
+        m_jobs.push_back(job);
+    }
+
+    // called by other workers; returns nullptr on failure
+    job_ptr try_steal() {
+        if (!m_lock.try_lock()) return nullptr;
+        job_ptr result = nullptr;
+        if (!m_jobs.empty()) {
+            result = m_jobs.front();
+            m_jobs.pop_front();
+        }
+        m_lock.unlock();
+        return result;
+    }
+
+    // removes all remaining jobs; called after the worker has been joined
+    template<typename F>
+    void flush(F fun) {
+        guard_type guard(m_lock);
+        for (auto job : m_jobs) fun(job);
+        m_jobs.clear();
+    }
+
+    void operator()();
+
+ private:
+
+    job_ptr pop_local() {
+        guard_type guard(m_lock);
+        if (m_jobs.empty()) return nullptr;
+        auto result = m_jobs.back();
+        m_jobs.pop_back();
+        return result;
+    }
+
+    job_ptr steal_from(const std::vector<worker*>& victims) {
+        if (victims.empty()) return nullptr;
+        std::uniform_int_distribution<size_t> dist(0, victims.size() - 1);
+        // try each victim at most once, starting at a random one
+        auto first = dist(m_rng);
+        for (size_t i = 0; i < victims.size(); ++i) {
+            auto result = victims[(first + i) % victims.size()]->try_steal();
+            if (result) return result;
+        }
+        return nullptr;
+    }
+
+    job_ptr try_dequeue() {
+        auto result = pop_local();
+        if (result) return result;
+        auto& queues = m_parent->m_queues;
+        result = queues[m_node]->try_pop();
+        if (result) return result;
+        result = steal_from(m_near);
+        if (result) return result;
+        // leaving our node is the last resort
+        for (size_t i = 1; i < queues.size(); ++i) {
+            result = queues[(m_node + i) % queues.size()]->try_pop();
+            if (result) return result;
+        }
+        return steal_from(m_far);
+    }
+
+    work_stealing_scheduler* m_parent;
+    size_t m_id;
+    size_t m_node;
+    int m_cpu;
+    std::minstd_rand m_rng;
+    std::vector<worker*> m_near;
+    std::vector<worker*> m_far;
+    util::shared_spinlock m_lock;
+    std::deque<job_ptr> m_jobs;
+    std::thread m_thread;
+
+};
+
+namespace {
+
+// the worker of the calling thread or nullptr
+__thread work_stealing_scheduler::worker* t_worker = nullptr;
+
+} // namespace <anonymous>
+
+void work_stealing_scheduler::worker::operator()() {
+    CPPA_LOG_TRACE("id = " << m_id << ", node = " << m_node
+                   << ", cpu = " << m_cpu);
+    if (m_cpu >= 0 && !cpu_topology::pin_current_thread(m_cpu)) {
+        CPPA_LOG_WARNING("unable to pin worker " << m_id
+                         << " to CPU " << m_cpu);
+    }
+    t_worker = this;
+    detail::cs_thread fself;
+    job_ptr job = nullptr;
+    for (;;) {
+        job = m_parent->m_idle.await([&] { return try_dequeue(); });
+        CPPA_LOG_DEBUG("dequeued new job");
+        if (job == &m_parent->m_dummy) {
+            CPPA_LOG_DEBUG("received dummy (quit)");
+            // dummy of doom received ...
+            m_parent->m_queues.front()->push_back(job); // kill the next guy
+            m_parent->m_idle.notify();
+            t_worker = nullptr;
+            return;                                     // and say goodbye
+        }
+        switch (job->resume(&fself)) {
+            case resumable::done: {
+                CPPA_LOG_DEBUG("actor is done");
+                get_actor_registry()->dec_running();
+                break;
+            }
+            case resumable::reschedule: {
+                // the local deque is LIFO, i.e., pushing the job there
+                // would resume it right away; use the FIFO node queue
+                // instead to give other jobs a chance
+                m_parent->m_queues[m_node]->push_back(job);
+                m_parent->m_idle.notify();
+                break;
+            }
+            default: break;
+        }
+        job = nullptr;
+    }
+}
+
+void work_stealing_scheduler::worker_loop(work_stealing_scheduler::worker* w) {
+    (*w)();
+}
+
+work_stealing_scheduler::work_stealing_scheduler() : m_pin_workers(false) {
+    m_num_threads = std::max<size_t>(std::thread::hardware_concurrency(), 4);
+}
+
+work_stealing_scheduler::work_stealing_scheduler(size_t num_worker_threads,
+        const idle_strategy::settings& idle_settings, bool pin_workers)
+: m_pin_workers(pin_workers), m_idle(idle_settings) {
+    m_num_threads = num_worker_threads;
+}
+
+work_stealing_scheduler::~work_stealing_scheduler() { }
+
+void work_stealing_scheduler::supervisor_loop(work_stealing_scheduler* self) {
+    for (auto& w : self->m_workers) w->start();
+    // wait for workers
+    for (auto& w : self->m_workers) w->join();
+}
+
+void work_stealing_scheduler::initialize() {
+    size_t num_nodes = 1;
+    if (m_pin_workers) {
+        m_topology = cpu_topology::detect();
+        num_nodes = m_topology.num_nodes();
+    }
+    for (size_t i = 0; i < num_nodes; ++i) {
+        m_queues.emplace_back(new job_queue);
+    }
+    // all workers must exist before the first one starts stealing
+    for (size_t i = 0; i < m_num_threads; ++i) {
+        auto node = i % num_nodes;
+        int cpu = -1;
+        if (m_pin_workers) {
+            auto& cpus = m_topology.cpus(node);
+            cpu = cpus[(i / num_nodes) % cpus.size()];
+        }
+        m_workers.emplace_back(new worker(this, i, node, cpu));
+    }
+    for (auto& w : m_workers) {
+        std::vector<worker*> near;
+        std::vector<worker*> far;
+        for (auto& other : m_workers) {
+            if (other == w) continue;
+            if (other->node() == w->node()) near.push_back(other.get());
+            else far.push_back(other.get());
+        }
+        w->set_victims(std::move(near), std::move(far));
+    }
+    m_supervisor = std::thread(&work_stealing_scheduler::supervisor_loop, this);
+    super::initialize();
+}
+
+void work_stealing_scheduler::destroy() {
+    CPPA_LOG_TRACE("");
+    m_queues.front()->push_back(&m_dummy);
+    m_idle.notify();
+    CPPA_LOG_DEBUG("join supervisor");
+    m_supervisor.join();
+    // make sure all queues are empty; each remaining job is
+    // a running actor that will never be resumed
+    CPPA_LOG_DEBUG("flush queues");
+    auto flush = [&](resumable* ptr) {
+        if (ptr != &m_dummy) get_actor_registry()->dec_running();
+    };
+    for (auto& w : m_workers) w->flush(flush);
+    for (auto& q : m_queues) {
+        auto ptr = q->try_pop();
+        while (ptr != nullptr) {
+            flush(ptr);
+            ptr = q->try_pop();
+        }
+    }
+    super::destroy();
+}
+
+size_t work_stealing_scheduler::num_timers() const {
+    return m_num_threads;
+}
+
+void work_stealing_scheduler::enqueue(resumable* what) {
+    auto w = t_worker;
+    if (w != nullptr && w->parent() == this) w->push_local(what);
+    else m_queues[m_topology.current_node()]->push_back(what);
+    // wake up a parked worker, which either takes the job from the
+    // shared queue or steals it
+    m_idle.notify();
+}
+
+} } // namespace cppa::detail
@@ -28,10 +28,15 @@
 \******************************************************************************/
 
 
+#include <atomic>
+#include <thread>
+#include <vector>
 #include <iterator>
 
 #include "test.hpp"
 #include "cppa/intrusive/single_reader_queue.hpp"
+#include "cppa/intrusive/singly_linked_list.hpp"
+#include "cppa/intrusive/producer_consumer_list.hpp"
 
 using std::begin;
 using std::end;
@@ -59,6 +64,107 @@ inline bool operator==(int lhs, const iint& rhs) {
 
 typedef cppa::intrusive::single_reader_queue<iint> iint_queue;
 
+struct aint {
+    std::atomic<aint*> next;
+    int producer;
+    int value;
+    inline aint(int p = 0, int v = 0) : next(nullptr), producer(p), value(v) { }
+};
+
+typedef cppa::intrusive::singly_linked_list<iint> iint_list;
+
+std::vector<int> values(iint_list& list) {
+    std::vector<int> result;
+    for (auto i = list.begin(); i != list.end(); ++i) {
+        result.push_back(i->value);
+    }
+    return result;
+}
+
+void test_singly_linked_list() {
+    iint_list list;
+    CPPA_CHECK(list.empty());
+    for (int i = 1; i <= 5; ++i) list.push_back(new iint(i));
+    list.push_front(new iint(0));
+    CPPA_CHECK_EQUAL(list.size(), 6);
+    CPPA_CHECK((values(list) == std::vector<int>{0, 1, 2, 3, 4, 5}));
+    // take odd elements in a single pass, keeping the others in place
+    std::vector<iint*> odd;
+    auto e = list.end();
+    for (auto i = list.begin(); i != e; ) {
+        if (i->value % 2 == 1) odd.push_back(list.take(i));
+        else ++i;
+    }
+    CPPA_CHECK((values(list) == std::vector<int>{0, 2, 4}));
+    CPPA_CHECK_EQUAL(odd.size(), 3);
+    // put them back to their original position
+    auto j = odd.begin();
+    for (auto i = list.begin(); j != odd.end(); ++i) {
+        if (i == e || (*j)->value < i->value) list.insert(i, *j++);
+    }
+    CPPA_CHECK((values(list) == std::vector<int>{0, 1, 2, 3, 4, 5}));
+    // tail must be updated after taking the last element
+    auto last = list.begin();
+    for (int i = 0; i < 5; ++i) ++last;
+    delete list.take(last);
+    list.push_back(new iint(6));
+    CPPA_CHECK((values(list) == std::vector<int>{0, 1, 2, 3, 4, 6}));
+    list.erase(list.begin());
+    delete list.take_front();
+    CPPA_CHECK_EQUAL(list.size(), 4);
+    list.clear();
+    CPPA_CHECK(list.empty());
+    CPPA_CHECK_EQUAL(0, s_iint_instances);
+}
+
+void test_producer_consumer_list() {
+    cppa::intrusive::producer_consumer_list<aint> q;
+    CPPA_CHECK(q.try_pop() == nullptr);
+    aint a{0, 1}, b{0, 2}, c{0, 3};
+    q.push_back(&a);
+    q.push_back(&b);
+    CPPA_CHECK(q.try_pop() == &a);
+    q.push_back(&c);
+    CPPA_CHECK(q.try_pop() == &b);
+    CPPA_CHECK(q.try_pop() == &c);
+    CPPA_CHECK(q.try_pop() == nullptr);
+    // elements can be enqueued again after they were dequeued
+    q.push_back(&a);
+    CPPA_CHECK(q.try_pop() == &a);
+    CPPA_CHECK(q.try_pop() == nullptr);
+    // each producer enqueues its elements in ascending order
+    constexpr int num_producers = 4;
+    constexpr int num_elements = 10000;
+    std::vector<std::vector<aint>> elements;
+    std::vector<std::thread> producers;
+    for (int p = 0; p < num_producers; ++p) {
+        elements.emplace_back(num_elements);
+        for (int i = 0; i < num_elements; ++i) {
+            elements.back()[i].producer = p;
+            elements.back()[i].value = i;
+        }
+    }
+    for (auto& vec : elements) {
+        producers.emplace_back([&vec, &q] {
+            for (auto& e : vec) q.push_back(&e);
+        });
+    }
+    std::vector<int> last_values(num_producers, -1);
+    bool in_order = true;
+    for (int received = 0; received < num_producers * num_elements; ) {
+        auto e = q.try_pop();
+        if (e) {
+            auto& last = last_values[e->producer];
+            if (e->value != last + 1) in_order = false;
+            last = e->value;
+            ++received;
+        }
+    }
+    for (auto& t : producers) t.join();
+    CPPA_CHECK(in_order);
+    CPPA_CHECK(q.try_pop() == nullptr);
+}
+
 int main() {
     CPPA_TEST(test_intrusive_containers);
 
@@ -81,5 +187,21 @@ int main() {
     x = q.try_pop();
     CPPA_CHECK(x == nullptr);
 
+    // drain elements in FIFO order with a limit
+    for (int i = 1; i <= 5; ++i) q.enqueue(new iint(i));
+    std::vector<int> drained;
+    auto collect = [&](iint* e) {
+        drained.push_back(e->value);
+        delete e;
+    };
+    CPPA_CHECK_EQUAL(q.drain(collect, 2), 2);
+    CPPA_CHECK_EQUAL(q.drain(collect), 3);
+    CPPA_CHECK_EQUAL(q.drain(collect), 0);
+    CPPA_CHECK((drained == std::vector<int>{1, 2, 3, 4, 5}));
+    CPPA_CHECK_EQUAL(0, s_iint_instances);
+
+    test_singly_linked_list();
+    test_producer_consumer_list();
+
     return CPPA_TEST_RESULT();
 }
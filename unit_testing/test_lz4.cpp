@@ -0,0 +1,67 @@
+#include <string>
+#include <vector>
+#include <random>
+
+#include "test.hpp"
+
+#include "cppa/util/lz4.hpp"
+
+using namespace cppa::util;
+
+namespace {
+
+// returns the compressed size or 0 if the round trip failed
+size_t round_trip(const std::string& what) {
+    std::vector<char> compressed(lz4_compress_bound(what.size()));
+    auto size = lz4_compress(what.data(), what.size(), compressed.data());
+    std::string restored(what.size(), '\0');
+    if (!lz4_decompress(compressed.data(), size,
+                        &restored[0], restored.size())) {
+        return 0;
+    }
+    return restored == what ? size : 0;
+}
+
+} // namespace <anonymous>
+
+int main() {
+    CPPA_TEST(test_lz4);
+
+    // inputs too small for any match are stored as literals
+    CPPA_CHECK_EQUAL(round_trip(""), 1);
+    CPPA_CHECK_EQUAL(round_trip("abc"), 4);
+
+    // repetitive data compresses well, including overlapping matches
+    std::string zeros(100000, '\0');
+    auto zsize = round_trip(zeros);
+    CPPA_CHECK(zsize > 0 && zsize < 1000);
+    std::string text;
+    for (int i = 0; i < 1000; ++i) {
+        text += "message number ";
+        text += std::to_string(i);
+        text += " from actor @process_info\n";
+    }
+    auto tsize = round_trip(text);
+    CPPA_CHECK(tsize > 0 && tsize < text.size() / 3);
+
+    // random data does not compress, but must survive the round trip
+    std::mt19937 rng(42);
+    std::string noise(100000, '\0');
+    for (auto& c : noise) c = static_cast<char>(rng());
+    auto nsize = round_trip(noise);
+    CPPA_CHECK(nsize >= noise.size() && nsize <= lz4_compress_bound(noise.size()));
+
+    // malformed input is rejected without reading or writing out of bounds
+    std::vector<char> compressed(lz4_compress_bound(text.size()));
+    auto size = lz4_compress(text.data(), text.size(), compressed.data());
+    std::string restored(text.size(), '\0');
+    CPPA_CHECK(!lz4_decompress(compressed.data(), size - 1,
+                               &restored[0], restored.size()));
+    CPPA_CHECK(!lz4_decompress(compressed.data(), size,
+                               &restored[0], restored.size() - 1));
+    const char bad_offset[] = {0x10, 'a', 0x02, 0x00};
+    CPPA_CHECK(!lz4_decompress(bad_offset, sizeof(bad_offset),
+                               &restored[0], restored.size()));
+
+    return CPPA_TEST_RESULT();
+}
@@ -0,0 +1,131 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+#include "cppa/cppa.hpp"
+#include "cppa/mailbox_element.hpp"
+
+#include "cppa/detail/memory.hpp"
+
+using namespace std;
+using namespace cppa;
+
+using detail::memory;
+
+namespace {
+
+typedef detail::basic_memory_cache<mailbox_element> element_cache;
+
+vector<mailbox_element*> create_elements(size_t num) {
+    vector<mailbox_element*> result;
+    result.reserve(num);
+    for (size_t i = 0; i < num; ++i) {
+        result.push_back(mailbox_element::create(message_header{},
+                                                 any_tuple{}));
+    }
+    return result;
+}
+
+void release_elements(vector<mailbox_element*>& elements) {
+    for (auto e : elements) detail::disposer{}(e);
+    elements.clear();
+}
+
+void test_local_reuse() {
+    thread([] {
+        auto elements = create_elements(100);
+        auto s0 = memory::stats<mailbox_element>();
+        CPPA_CHECK_EQUAL(s0.allocated_slabs, 1);
+        release_elements(elements);
+        auto s1 = memory::stats<mailbox_element>();
+        CPPA_CHECK(s1.cached_instances >= 100);
+        CPPA_CHECK_EQUAL(s1.remote_releases, 0);
+        // cached instances are re-used
+        elements = create_elements(100);
+        CPPA_CHECK_EQUAL(memory::stats<mailbox_element>().allocated_slabs, 1);
+        release_elements(elements);
+    }).join();
+}
+
+void test_remote_release() {
+    size_t num = 1000;
+    vector<mailbox_element*> elements;
+    thread([&] { elements = create_elements(num); }).join();
+    // elements are released on a thread that did not create them
+    thread([&] {
+        auto slabs = memory::stats<mailbox_element>().allocated_slabs;
+        release_elements(elements);
+        auto s = memory::stats<mailbox_element>();
+        CPPA_CHECK_EQUAL(s.allocated_slabs, slabs);
+        CPPA_CHECK_EQUAL(s.cached_instances, 0);
+    }).join();
+    // the owning thread must re-use elements released by other threads
+    thread([&] {
+        elements = create_elements(num);
+        auto slabs = memory::stats<mailbox_element>().allocated_slabs;
+        thread([&] { release_elements(elements); }).join();
+        auto s = memory::stats<mailbox_element>();
+        CPPA_CHECK_EQUAL(s.remote_releases, num);
+        elements = create_elements(num);
+        CPPA_CHECK_EQUAL(memory::stats<mailbox_element>().allocated_slabs,
+                         slabs);
+        release_elements(elements);
+    }).join();
+}
+
+void test_watermarks() {
+    thread([] {
+        size_t high = element_cache::high_watermark;
+        size_t low = element_cache::low_watermark;
+        auto elements = create_elements(high + 1);
+        release_elements(elements);
+        auto s = memory::stats<mailbox_element>();
+        CPPA_CHECK(s.cached_instances <= high);
+        CPPA_CHECK(s.cached_instances >= low);
+        // unused slabs are returned to the OS
+        CPPA_CHECK(s.released_slabs > 0);
+        CPPA_CHECK(s.released_slabs < s.allocated_slabs);
+    }).join();
+}
+
+} // namespace <anonymous>
+
+int main() {
+    CPPA_TEST(test_memory);
+    test_local_reuse();
+    test_remote_release();
+    test_watermarks();
+    shutdown();
+    return CPPA_TEST_RESULT();
+}
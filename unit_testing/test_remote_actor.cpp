@@ -325,6 +325,8 @@ class server : public event_based_actor {
 };
 
 int main(int argc, char** argv) {
+    // use several connections per node to cover connection pooling
+    remote_connections(3);
     announce<actor_vector>();
     announce_tuple<atom_value, int>();
     announce_tuple<atom_value, atom_value, int>();
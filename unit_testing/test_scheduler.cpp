@@ -0,0 +1,130 @@
+/******************************************************************************\
+ *           ___        __                                                    *
+ *          /\_ \    __/\ \                                                   *
+ *          \//\ \  /\_\ \ \____    ___   _____   _____      __               *
+ *            \ \ \ \/\ \ \ '__`\  /'___\/\ '__`\/\ '__`\  /'__`\             *
+ *             \_\ \_\ \ \ \ \L\ \/\ \__/\ \ \L\ \ \ \L\ \/\ \L\.\_           *
+ *             /\____\\ \_\ \_,__/\ \____\\ \ ,__/\ \ ,__/\ \__/.\_\          *
+ *             \/____/ \/_/\/___/  \/____/ \ \ \/  \ \ \/  \/__/\/_/          *
+ *                                          \ \_\   \ \_\                     *
+ *                                           \/_/    \/_/                     *
+ *                                                                            *
+ * Copyright (C) 2011-2013                                                    *
+ * Dominik Charousset <dominik.charousset@haw-hamburg.de>                     *
+ *                                                                            *
+ * This file is part of libcppa.                                              *
+ * libcppa is free software: you can redistribute it and/or modify it under   *
+ * the terms of the GNU Lesser General Public License as published by the     *
+ * Free Software Foundation; either version 2.1 of the License,               *
+ * or (at your option) any later version.                                     *
+ *                                                                            *
+ * libcppa is distributed in the hope that it will be useful,                 *
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                       *
+ * See the GNU Lesser General Public License for more details.                *
+ *                                                                            *
+ * You should have received a copy of the GNU Lesser General Public License   *
+ * along with libcppa. If not, see <http://www.gnu.org/licenses/>.            *
+\******************************************************************************/
+
+
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#include "test.hpp"
+#include "cppa/cppa.hpp"
+
+#include "cppa/detail/resumable.hpp"
+#include "cppa/detail/cpu_topology.hpp"
+#include "cppa/detail/work_stealing_scheduler.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+constexpr size_t num_parents = 1000;
+constexpr size_t num_children = 10;
+
+atomic<size_t> s_resumed{0};
+
+struct child_job : detail::resumable {
+    resume_result resume(detail::cs_thread*) override {
+        ++s_resumed;
+        return resume_later;
+    }
+};
+
+// enqueues its children from within a worker, i.e., to the worker's own queue
+struct parent_job : detail::resumable {
+    child_job children[num_children];
+    resume_result resume(detail::cs_thread*) override {
+        for (auto& child : children) get_scheduler()->enqueue(&child);
+        ++s_resumed;
+        return resume_later;
+    }
+};
+
+// uses up its throughput budget a few times before it is done
+struct greedy_job : detail::resumable {
+    size_t slices = 0;
+    resume_result resume(detail::cs_thread*) override {
+        if (++slices < 5) return reschedule;
+        ++s_resumed;
+        return resume_later;
+    }
+};
+
+template<typename Predicate>
+void await_condition(Predicate pred) {
+    for (int i = 0; i < 1000 && !pred(); ++i) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+}
+
+} // namespace <anonymous>
+
+int main() {
+    CPPA_TEST(test_scheduler);
+    using detail::cpu_topology;
+    CPPA_CHECK(cpu_topology::parse_cpu_list("0-3,8,10-11\n")
+               == vector<int>({0, 1, 2, 3, 8, 10, 11}));
+    CPPA_CHECK(cpu_topology::parse_cpu_list("").empty());
+    auto topology = cpu_topology::detect();
+    CPPA_CHECK(topology.num_nodes() > 0);
+    CPPA_CHECK(!topology.cpus(0).empty());
+    // use few polling iterations to make sure workers get parked quickly
+    // and pin workers to exercise the NUMA-aware setup
+    auto sched = new detail::work_stealing_scheduler(4, {10, 10}, true);
+    set_scheduler(sched);
+    vector<parent_job> jobs(num_parents);
+    for (auto& job : jobs) get_scheduler()->enqueue(&job);
+    auto expected = num_parents * (num_children + 1);
+    await_condition([&] { return s_resumed.load() == expected; });
+    CPPA_CHECK_EQUAL(s_resumed.load(), expected);
+    // all workers are idle now and eventually parked
+    await_condition([&] { return sched->idle_statistics().parks >= 4; });
+    CPPA_CHECK(sched->idle_statistics().parks >= 4);
+    // a new job must wake up a parked worker
+    child_job straggler;
+    get_scheduler()->enqueue(&straggler);
+    await_condition([&] { return s_resumed.load() == expected + 1; });
+    CPPA_CHECK_EQUAL(s_resumed.load(), expected + 1);
+    CPPA_CHECK(sched->idle_statistics().wakeups > 0);
+    // rescheduled jobs must be resumed again by the workers
+    greedy_job greedy;
+    get_scheduler()->enqueue(&greedy);
+    await_condition([&] { return s_resumed.load() == expected + 2; });
+    CPPA_CHECK_EQUAL(greedy.slices, 5);
+    CPPA_CHECK_EQUAL(max_throughput(), numeric_limits<size_t>::max());
+    set_max_throughput(0);
+    CPPA_CHECK_EQUAL(max_throughput(), 1);
+    set_max_throughput(numeric_limits<size_t>::max());
+    await_all_actors_done();
+    shutdown();
+    return CPPA_TEST_RESULT();
+}
@@ -39,6 +39,7 @@
 #include "cppa/primitive_type.hpp"
 #include "cppa/actor_namespace.hpp"
 #include "cppa/primitive_variant.hpp"
+#include "cppa/type_lookup_table.hpp"
 #include "cppa/binary_serializer.hpp"
 #include "cppa/binary_deserializer.hpp"
 #include "cppa/util/get_mac_addresses.hpp"
@@ -113,6 +114,11 @@ struct raw_struct {
     string str;
 };
 
+// disables the statically bound fast path of binary_serializer
+struct virtual_binary_serializer : binary_serializer {
+    using binary_serializer::binary_serializer;
+};
+
 bool operator==(const raw_struct& lhs, const raw_struct& rhs) {
     return lhs.str == rhs.str;
 }
@@ -278,6 +284,128 @@ int main() {
     }
     catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
 
+    try { // wire format v2 with varints and interned type names
+        auto msg = make_any_tuple(static_cast<int32_t>(-5),
+                                  static_cast<uint64_t>(1) << 40,
+                                  string("foo"));
+        util::buffer v1_buf;
+        binary_serializer bs1(&v1_buf, &addressing);
+        bs1 << msg;
+        type_lookup_table out_types;
+        type_lookup_table in_types;
+        util::buffer v2_buf1;
+        util::buffer v2_buf2;
+        binary_serializer bs2(&v2_buf1, &addressing, &out_types,
+                              wire_format::v2);
+        bs2.intern_types(true);
+        bs2 << msg;
+        binary_serializer bs3(&v2_buf2, &addressing, &out_types,
+                              wire_format::v2);
+        bs3.intern_types(true);
+        bs3 << msg;
+        CPPA_CHECK(v2_buf1.size() < v1_buf.size());
+        // the second message refers to interned types by id only
+        CPPA_CHECK(v2_buf2.size() < v2_buf1.size());
+        for (auto buf : {&v2_buf1, &v2_buf2}) {
+            binary_deserializer bd(buf->data(), buf->size(), &addressing,
+                                   &in_types, wire_format::v2);
+            any_tuple msg2;
+            uniform_typeid<any_tuple>()->deserialize(&msg2, &bd);
+            auto opt = tuple_cast<int32_t, uint64_t, string>(msg2);
+            CPPA_CHECK(opt.valid());
+            if (opt.valid()) {
+                auto& tup = *opt;
+                CPPA_CHECK_EQUAL(get<0>(tup), -5);
+                CPPA_CHECK_EQUAL(get<1>(tup), static_cast<uint64_t>(1) << 40);
+                CPPA_CHECK_EQUAL(get<2>(tup), "foo");
+            }
+        }
+    }
+    catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
+
+    try { // statically bound and virtual serialization are equivalent
+        announce<struct_a>(&struct_a::x, &struct_a::y);
+        announce<struct_b>(&struct_b::a, &struct_b::z, &struct_b::ints);
+        announce<struct_c>(&struct_c::strings, &struct_c::ints);
+        announce<vector<raw_struct>>();
+        struct_b b1{{1, -2}, 3, {4, 5, 6}};
+        struct_c c1{{{"foo", u"bar"}}, {7, 8}};
+        auto msg = make_any_tuple(b1, c1, vector<raw_struct>{{"baz"}});
+        for (auto format : {wire_format::v1, wire_format::v2}) {
+            util::buffer fast_buf;
+            util::buffer slow_buf;
+            binary_serializer fast(&fast_buf, &addressing, nullptr, format);
+            virtual_binary_serializer slow(&slow_buf, &addressing,
+                                           nullptr, format);
+            fast << msg;
+            slow << msg;
+            CPPA_CHECK_EQUAL(fast_buf.size(), slow_buf.size());
+            CPPA_CHECK(memcmp(fast_buf.data(), slow_buf.data(),
+                              min(fast_buf.size(), slow_buf.size())) == 0);
+            binary_deserializer bd(fast_buf.data(), fast_buf.size(),
+                                   &addressing, nullptr, format);
+            any_tuple msg2;
+            uniform_typeid<any_tuple>()->deserialize(&msg2, &bd);
+            auto opt = tuple_cast<struct_b, struct_c, vector<raw_struct>>(msg2);
+            CPPA_CHECK(opt.valid());
+            if (opt.valid()) {
+                CPPA_CHECK(get<0>(*opt) == b1);
+                CPPA_CHECK(get<1>(*opt) == c1);
+                CPPA_CHECK_EQUAL(get<2>(*opt).front().str, "baz");
+            }
+        }
+    }
+    catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
+
+    try { // vectors of arithmetic types are written as one block
+        announce<vector<int32_t>>();
+        announce<vector<double>>();
+        announce<vector<uint8_t>>();
+        vector<int32_t> ints{1, -2, 3, numeric_limits<int32_t>::max()};
+        vector<double> doubles{0.5, -1.25, 1e300};
+        vector<uint8_t> bytes{0, 1, 255};
+        auto msg = make_any_tuple(ints, doubles, bytes, vector<int32_t>{});
+        for (auto format : {wire_format::v1, wire_format::v2}) {
+            util::buffer fast_buf;
+            util::buffer slow_buf;
+            binary_serializer fast(&fast_buf, &addressing, nullptr, format);
+            virtual_binary_serializer slow(&slow_buf, &addressing,
+                                           nullptr, format);
+            fast << msg;
+            slow << msg;
+            CPPA_CHECK_EQUAL(fast_buf.size(), slow_buf.size());
+            CPPA_CHECK(memcmp(fast_buf.data(), slow_buf.data(),
+                              min(fast_buf.size(), slow_buf.size())) == 0);
+            binary_deserializer bd(fast_buf.data(), fast_buf.size(),
+                                   &addressing, nullptr, format);
+            any_tuple msg2;
+            uniform_typeid<any_tuple>()->deserialize(&msg2, &bd);
+            auto opt = tuple_cast<vector<int32_t>, vector<double>,
+                                  vector<uint8_t>, vector<int32_t>>(msg2);
+            CPPA_CHECK(opt.valid());
+            if (opt.valid()) {
+                CPPA_CHECK(get<0>(*opt) == ints);
+                CPPA_CHECK(get<1>(*opt) == doubles);
+                CPPA_CHECK(get<2>(*opt) == bytes);
+                CPPA_CHECK(get<3>(*opt).empty());
+            }
+        }
+        // a sequence size exceeding the buffer is rejected before allocating
+        util::buffer buf;
+        binary_serializer bs(&buf, &addressing);
+        bs << ints;
+        uint32_t bogus_size = numeric_limits<uint32_t>::max();
+        memcpy(buf.data(), &bogus_size, sizeof(uint32_t));
+        binary_deserializer bd(buf.data(), buf.size(), &addressing);
+        vector<int32_t> tmp;
+        try {
+            uniform_typeid<vector<int32_t>>()->deserialize(&tmp, &bd);
+            CPPA_FAILURE("bogus sequence size not detected");
+        }
+        catch (out_of_range&) { CPPA_CHECKPOINT(); }
+    }
+    catch (exception& e) { CPPA_FAILURE(to_verbose_string(e)); }
+
     CPPA_CHECK((is_iterable<int>::value) == false);
     // string is primitive and thus not identified by is_iterable
     CPPA_CHECK((is_iterable<string>::value) == false);
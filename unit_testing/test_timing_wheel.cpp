@@ -0,0 +1,124 @@
+#include <map>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cstdint>
+
+#include "test.hpp"
+
+#include "cppa/detail/timing_wheel.hpp"
+
+using namespace std;
+using namespace cppa;
+
+namespace {
+
+typedef detail::timing_wheel<int> wheel;
+
+typedef wheel::time_point time_point;
+
+constexpr chrono::milliseconds res{1};
+
+} // namespace <anonymous>
+
+int main() {
+    CPPA_TEST(test_timing_wheel);
+    auto t0 = wheel::clock_type::now();
+    vector<int> fired;
+    auto collect = [&](int i) { fired.push_back(i); };
+
+    // entries fire in order of their deadlines and never early
+    wheel w1{res, t0};
+    CPPA_CHECK(w1.next_timeout() == time_point::max());
+    w1.add(t0 + chrono::milliseconds(3), 3);
+    w1.add(t0 + chrono::milliseconds(1), 1);
+    w1.add(t0 + chrono::milliseconds(2), 2);
+    CPPA_CHECK_EQUAL(w1.size(), 3);
+    CPPA_CHECK(w1.next_timeout() == t0 + chrono::milliseconds(1));
+    CPPA_CHECK_EQUAL(w1.advance(t0, collect), 0);
+    CPPA_CHECK_EQUAL(w1.advance(t0 + chrono::microseconds(2500), collect), 2);
+    CPPA_CHECK((fired == vector<int>{1, 2}));
+    CPPA_CHECK_EQUAL(w1.advance(t0 + chrono::milliseconds(3), collect), 1);
+    CPPA_CHECK(w1.empty());
+
+    // deadlines between two ticks are rounded up
+    fired.clear();
+    wheel w2{res, t0};
+    w2.add(t0 + chrono::microseconds(1500), 1);
+    CPPA_CHECK(w2.next_timeout() == t0 + chrono::milliseconds(2));
+    w2.advance(t0 + chrono::microseconds(1999), collect);
+    CPPA_CHECK(fired.empty());
+    w2.advance(t0 + chrono::milliseconds(2), collect);
+    CPPA_CHECK((fired == vector<int>{1}));
+
+    // cancelled entries never fire
+    fired.clear();
+    wheel w3{res, t0};
+    auto e1 = w3.add(t0 + chrono::milliseconds(10), 1);
+    w3.add(t0 + chrono::milliseconds(10), 2);
+    auto e3 = w3.add(t0 + chrono::seconds(10), 3);
+    w3.cancel(e1);
+    w3.cancel(e3);
+    CPPA_CHECK_EQUAL(w3.size(), 1);
+    w3.advance(t0 + chrono::seconds(20), collect);
+    CPPA_CHECK((fired == vector<int>{2}));
+    CPPA_CHECK(w3.empty());
+
+    // compare against a multimap using deadlines on all levels
+    fired.clear();
+    wheel w4{res, t0};
+    multimap<int64_t, int> expected;
+    vector<wheel::entry*> handles;
+    mt19937 rng{42};
+    uniform_int_distribution<int> level{0, 3};
+    for (int i = 0; i < 10000; ++i) {
+        int64_t max_ms = int64_t{1} << (8 * (level(rng) + 1));
+        uniform_int_distribution<int64_t> dist{0, max_ms};
+        auto ms = dist(rng);
+        handles.push_back(w4.add(t0 + chrono::milliseconds(ms), i));
+        expected.emplace(ms, i);
+    }
+    // cancel every 7th entry
+    for (size_t i = 0; i < handles.size(); i += 7) {
+        w4.cancel(handles[i]);
+        for (auto j = expected.begin(); j != expected.end(); ++j) {
+            if (j->second == static_cast<int>(i)) {
+                expected.erase(j);
+                break;
+            }
+        }
+    }
+    CPPA_CHECK_EQUAL(w4.size(), expected.size());
+    // advance in irregular steps, verifying each fired deadline
+    vector<int64_t> deadlines(handles.size());
+    for (auto& kvp : expected) deadlines[kvp.second] = kvp.first;
+    bool in_time = true;
+    bool in_order = true;
+    bool no_oversleep = true;
+    auto pending = expected;
+    int64_t last_deadline = 0;
+    int64_t before = -1;
+    int64_t now = 0;
+    while (!w4.empty()) {
+        // the wheel must not sleep past the earliest deadline
+        auto earliest = t0 + chrono::milliseconds(pending.begin()->first);
+        if (w4.next_timeout() > earliest) no_oversleep = false;
+        w4.advance(t0 + chrono::milliseconds(now), [&](int i) {
+            // each entry fires in the first call after its deadline
+            if (deadlines[i] > now || deadlines[i] <= before) in_time = false;
+            if (deadlines[i] < last_deadline) in_order = false;
+            last_deadline = deadlines[i];
+            auto j = pending.find(deadlines[i]);
+            while (j->second != i) ++j;
+            pending.erase(j);
+            fired.push_back(i);
+        });
+        before = now;
+        now += 1 + now / 100;
+    }
+    CPPA_CHECK(in_time);
+    CPPA_CHECK(in_order);
+    CPPA_CHECK(no_oversleep);
+    CPPA_CHECK_EQUAL(fired.size(), expected.size());
+    return CPPA_TEST_RESULT();
+}